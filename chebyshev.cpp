@@ -5,9 +5,11 @@
 #include <iostream>
 #include <string>
 #include <bitset>
+#include <algorithm>
 
 #include <gmpxx.h>
 #include <mpreal.h>
+#include "chebyshev.hpp"
 
 using namespace std;
 
@@ -143,8 +145,9 @@ mpfr::mpreal mod_mpreal(mpfr::mpreal a, mpfr::mpreal b) {
 
 
 
-// Do the expensive iteration while counting the number of calculations.
-mpf_class chebyshev_expensive_count(mpf_class x, mpz_class s, mpz_class& count) {
+// Do the expensive iteration, one call of policy.step() per step.
+template <class Policy>
+mpf_class chebyshev_expensive_policy(const mpf_class& x, const mpz_class& s, Policy& policy) {
 	mpf_class t_prev = 1;
 	mpf_class t_curr = x;
 	mpf_class t_next;
@@ -152,22 +155,28 @@ mpf_class chebyshev_expensive_count(mpf_class x, mpz_class s, mpz_class& count)
 		t_next = 2*x*t_curr - t_prev;
 		t_prev = t_curr;
 		t_curr = t_next;
-		count += 1;
+		policy.step();
 	}
 	return t_prev;
 }
 
+template mpf_class chebyshev_expensive_policy<count_none>(const mpf_class&, const mpz_class&, count_none&);
+template mpf_class chebyshev_expensive_policy<count_total>(const mpf_class&, const mpz_class&, count_total&);
+template mpf_class chebyshev_expensive_policy<count_detailed>(const mpf_class&, const mpz_class&, count_detailed&);
+
 // Do the expensive iteration while counting the number of calculations.
+// The steps are counted in a uint64_t, and added to count once at the end.
+mpf_class chebyshev_expensive_count(mpf_class x, mpz_class s, mpz_class& count) {
+	count_total policy;
+	mpf_class result = chebyshev_expensive_policy(x, s, policy);
+	count += (unsigned long)policy.calculations;
+	return result;
+}
+
+// Do the expensive iteration without counting the number of calculations.
 mpf_class chebyshev_expensive(mpf_class x, mpz_class s) {
-	mpf_class t_prev = 1;
-	mpf_class t_curr = x;
-	mpf_class t_next;
-	for (mpz_class i = 0; i < s; i++) {
-		t_next = 2*x*t_curr - t_prev;
-		t_prev = t_curr;
-		t_curr = t_next;
-	}
-	return t_prev;
+	count_none policy;
+	return chebyshev_expensive_policy(x, s, policy);
 }
 
 /*------------------------------- Binary Representation of n -------------------------------*/
@@ -230,12 +239,125 @@ mpf_class* matrix_power(mpf_class* u, mpz_class n) {
 }
 
 
+/*--------------------------------- In-place Matrix Kernel on mpf_t ---------------------------------*/
+
+
+// The limbs of every entry and of the scratch are allocated once here, at precision prec,
+// so the kernels below never allocate, they only write into the limbs we already have.
+matrix_mpf::matrix_mpf(mp_bitcnt_t prec) {
+	for (int i = 0; i < 4; i++) {
+		mpf_init2(a[i], prec);
+	}
+	for (int i = 0; i < 3; i++) {
+		mpf_init2(scratch[i], prec);
+	}
+}
+
+matrix_mpf::~matrix_mpf() {
+	for (int i = 0; i < 4; i++) {
+		mpf_clear(a[i]);
+	}
+	for (int i = 0; i < 3; i++) {
+		mpf_clear(scratch[i]);
+	}
+}
+
+void matrix_mpf_set(matrix_mpf& u, const matrix_mpf& v) {
+	for (int i = 0; i < 4; i++) {
+		mpf_set(u.a[i], v.a[i]);
+	}
+}
+
+void matrix_mpf_set_identity(matrix_mpf& u) {
+	mpf_set_ui(u.a[0], 1);
+	mpf_set_ui(u.a[1], 0);
+	mpf_set_ui(u.a[2], 0);
+	mpf_set_ui(u.a[3], 1);
+}
+
+// Mx = [0, -1; 1, 2x], the matrix of one step Tk+1(x) = 2xTk(x) - Tk-1(x).
+void matrix_mpf_set_mx(matrix_mpf& u, const mpf_t x) {
+	mpf_set_ui(u.a[0], 0);
+	mpf_set_si(u.a[1], -1);
+	mpf_set_ui(u.a[2], 1);
+	mpf_mul_2exp(u.a[3], x, 1);
+}
+
+// u = u*v, in place. The new first row only needs the old first row, so we can swap it in before the second one.
+void matrix_mpf_multiplication(matrix_mpf& u, const matrix_mpf& v) {
+	if (&u == &v) {
+		matrix_mpf_square(u);
+		return;
+	}
+	mpf_t* s = u.scratch;
+	mpf_mul(s[0], u.a[0], v.a[0]);
+	mpf_mul(s[2], u.a[1], v.a[2]);
+	mpf_add(s[0], s[0], s[2]);
+	mpf_mul(s[1], u.a[0], v.a[1]);
+	mpf_mul(s[2], u.a[1], v.a[3]);
+	mpf_add(s[1], s[1], s[2]);
+	mpf_swap(u.a[0], s[0]);
+	mpf_swap(u.a[1], s[1]);
+
+	mpf_mul(s[0], u.a[2], v.a[0]);
+	mpf_mul(s[2], u.a[3], v.a[2]);
+	mpf_add(s[0], s[0], s[2]);
+	mpf_mul(s[1], u.a[2], v.a[1]);
+	mpf_mul(s[2], u.a[3], v.a[3]);
+	mpf_add(s[1], s[1], s[2]);
+	mpf_swap(u.a[2], s[0]);
+	mpf_swap(u.a[3], s[1]);
+}
+
+// u = u*u, in place.
+// u*u = [u0^2 + u1*u2, u1*(u0+u3); u2*(u0+u3), u3^2 + u1*u2], which needs 5 multiplications instead of 8.
+void matrix_mpf_square(matrix_mpf& u) {
+	mpf_t* s = u.scratch;
+	mpf_mul(s[0], u.a[1], u.a[2]);
+	mpf_add(s[1], u.a[0], u.a[3]);
+	mpf_mul(s[2], u.a[0], u.a[0]);
+	mpf_add(u.a[0], s[2], s[0]);
+	mpf_mul(s[2], u.a[3], u.a[3]);
+	mpf_add(u.a[3], s[2], s[0]);
+	mpf_mul(u.a[1], u.a[1], s[1]);
+	mpf_mul(u.a[2], u.a[2], s[1]);
+}
+
+// u = u*Mx, in place, where two_x = 2x.
+// u*Mx = [u1, 2x*u1 - u0; u3, 2x*u3 - u2], which needs 2 multiplications.
+void matrix_mpf_multiplication_mx(matrix_mpf& u, const mpf_t two_x) {
+	mpf_t* s = u.scratch;
+	mpf_mul(s[0], two_x, u.a[1]);
+	mpf_sub(s[0], s[0], u.a[0]);
+	mpf_swap(u.a[0], u.a[1]);
+	mpf_swap(u.a[1], s[0]);
+	mpf_mul(s[0], two_x, u.a[3]);
+	mpf_sub(s[0], s[0], u.a[2]);
+	mpf_swap(u.a[2], u.a[3]);
+	mpf_swap(u.a[3], s[0]);
+}
+
+chebyshev_workspace::chebyshev_workspace(mp_bitcnt_t prec) : p(prec) {
+	for (int i = 0; i < 3; i++) {
+		mpf_init2(t[i], prec);
+	}
+}
+
+chebyshev_workspace::~chebyshev_workspace() {
+	for (int i = 0; i < 3; i++) {
+		mpf_clear(t[i]);
+	}
+}
+
+
+
 /*---------------------------------- Economical Method -----------------------------------*/
 
 
-// Do the economical iteration while counting the number of calculations.
+// Do the economical iteration, one call of policy.square() or policy.multiply() per matrix product.
 //x is the variable you want for Tn(x), n is the index number of iterations you want from Chebyshev Polynomial.
-mpf_class chebyshev_economical_count(mpf_class x, mpz_class n, mpz_class& count) {
+template <class Policy>
+mpf_class chebyshev_economical_policy(const mpf_class& x, mpz_class n, Policy& policy) {
 	// This algorithm does one more in default, so we need to substract one of the number of iterations.
 	n = n - 1;
 	int len_n = count_digits_mpz(n);
@@ -268,16 +390,15 @@ mpf_class chebyshev_economical_count(mpf_class x, mpz_class n, mpz_class& count)
 			// 2^k, matrix power from opposite direction.
 			for (int j = 0; j < 4*len_n - 1 - i; j++) {
 				tmp = matrix_multiplication(tmp, tmp);
-				// everytime matrix_multiplication will do 3 times of calculation of our term.
-				count += 2;
+				policy.square();
 			}
 			// If j == 4*len_n, the above does nothing and Mx = Mx*tmp, which is 2^0.
 			Mx = matrix_multiplication(Mx, tmp);
-			count += 2;
+			policy.multiply();
 		}
 	}
 	t = matrix_multiplication(t, Mx);
-	count += 2;
+	policy.multiply();
 
 	mpf_class result = t[0];
 	delete[] binary_rep;
@@ -288,59 +409,755 @@ mpf_class chebyshev_economical_count(mpf_class x, mpz_class n, mpz_class& count)
 	return result;
 }
 
+template mpf_class chebyshev_economical_policy<count_none>(const mpf_class&, mpz_class, count_none&);
+template mpf_class chebyshev_economical_policy<count_total>(const mpf_class&, mpz_class, count_total&);
+template mpf_class chebyshev_economical_policy<count_detailed>(const mpf_class&, mpz_class, count_detailed&);
+
+// Do the economical iteration while counting the number of calculations.
+// The matrix products are counted in a uint64_t, and added to count once at the end.
+mpf_class chebyshev_economical_count(mpf_class x, mpz_class n, mpz_class& count) {
+	count_total policy;
+	mpf_class result = chebyshev_economical_policy(x, n, policy);
+	count += (unsigned long)policy.calculations;
+	return result;
+}
+
 // Do the economical iteration without counting the number of calculations.
 //x is the variable you want for Tn(x), n is the index number of iterations you want from Chebyshev Polynomial.
 mpf_class chebyshev_economical(mpf_class x, mpz_class n) {
+	count_none policy;
+	return chebyshev_economical_policy(x, n, policy);
+}
+
+
+
+/*---------------------------------- Binary Ladder Method -----------------------------------*/
+
+
+// The number of calculations chebyshev_economical_count reports for Tn(x), computed from the bits of n-1 only.
+// Every set bit 2^k costs k squarings plus one multiplication into Mx, and the final t*Mx costs one more,
+// where each matrix_multiplication is counted as 2 calculations of our term.
+mpz_class chebyshev_economical_operations(mpz_class n) {
+	n = n - 1;
+	mpz_class count = 2;
+	if (n <= 0) {
+		return count;
+	}
+	mp_bitcnt_t k = mpz_scan1(n.get_mpz_t(), 0);
+	while (k != ~(mp_bitcnt_t)0) {
+		count += 2*(k + 1);
+		k = mpz_scan1(n.get_mpz_t(), k + 1);
+	}
+	return count;
+}
+
+// Do the ladder iteration on mpf_t, with every temporary taken from the workspace w.
+// Scan the bits of n from high to low order once: p = p*p for every bit, and p = p*Mx if the bit is 1,
+// so p = Mx^n after log2(n) steps, and [T0(x), T1(x)] * Mx^n = [Tn(x), Tn+1(x)].
+void chebyshev_ladder_mpf(mpf_t result, const mpf_t x, const mpz_t n, chebyshev_workspace& w) {
+	// Tn(x) = T-n(x), since Tn(cos(a)) = cos(na). A read-only view of |n| shares the limbs of n.
+	mpz_t abs_n;
+	mpz_roinit_n(abs_n, mpz_limbs_read(n), mpz_size(n));
+
+	matrix_mpf& p = w.p;
+	mpf_t& two_x = w.t[0];
+	matrix_mpf_set_identity(p);
+	mpf_mul_2exp(two_x, x, 1);
+
+	for (mp_bitcnt_t i = mpz_sizeinbase(abs_n, 2); i-- > 0; ) {
+		matrix_mpf_square(p);
+		if (mpz_tstbit(abs_n, i)) {
+			matrix_mpf_multiplication_mx(p, two_x);
+		}
+	}
+
+	// Tn(x) = T0(x)*p0 + T1(x)*p2.
+	mpf_mul(result, x, p.a[2]);
+	mpf_add(result, result, p.a[0]);
+}
+
+// Do the ladder iteration without counting the number of calculations.
+mpf_class chebyshev_ladder(mpf_class x, mpz_class n) {
+	chebyshev_workspace w(mpf_get_default_prec());
+	mpf_class result;
+	chebyshev_ladder_mpf(result.get_mpf_t(), x.get_mpf_t(), n.get_mpz_t(), w);
+	return result;
+}
+
+// Do the ladder iteration while counting the number of calculations.
+// The count is the one of chebyshev_economical_count, so the tables built with the economical method still apply.
+mpf_class chebyshev_ladder_count(mpf_class x, mpz_class n, mpz_class& count) {
+	count += chebyshev_economical_operations(n);
+	return chebyshev_ladder(x, n);
+}
+
+
+
+/*---------------------------------- Doubling Method -----------------------------------*/
+
+
+// Do the doubling iteration on mpf_t, with every temporary taken from the workspace w.
+// We carry the pair (Tk(x), Tk+1(x)) and scan the bits of n from high to low order, with the identities
+// T2k(x) = 2Tk(x)^2 - 1, T2k+1(x) = 2Tk(x)Tk+1(x) - x, T2k+2(x) = 2Tk+1(x)^2 - 1,
+// such that bit 0 gives (T2k, T2k+1), and bit 1 gives (T2k+1, T2k+2), 2 multiplications per bit instead of a matrix product.
+void chebyshev_doubling_mpf(mpf_t result, const mpf_t x, const mpz_t n, chebyshev_workspace& w) {
+	// Tn(x) = T-n(x), since Tn(cos(a)) = cos(na). A read-only view of |n| shares the limbs of n.
+	mpz_t abs_n;
+	mpz_roinit_n(abs_n, mpz_limbs_read(n), mpz_size(n));
+
+	mpf_t& t_k = w.t[0];	//Tk(x)
+	mpf_t& t_k1 = w.t[1];	//Tk+1(x)
+	mpf_t& t_odd = w.t[2];	//T2k+1(x)
+	mpf_set_ui(t_k, 1);	//T0(x)
+	mpf_set(t_k1, x);	//T1(x)
+
+	for (mp_bitcnt_t i = mpz_sizeinbase(abs_n, 2); i-- > 0; ) {
+		// T2k+1(x) = 2Tk(x)Tk+1(x) - x, which is needed for both bits.
+		mpf_mul(t_odd, t_k, t_k1);
+		mpf_mul_2exp(t_odd, t_odd, 1);
+		mpf_sub(t_odd, t_odd, x);
+
+		if (mpz_tstbit(abs_n, i)) {
+			// (Tk, Tk+1) -> (T2k+1, T2k+2)
+			mpf_mul(t_k1, t_k1, t_k1);
+			mpf_mul_2exp(t_k1, t_k1, 1);
+			mpf_sub_ui(t_k1, t_k1, 1);
+			mpf_swap(t_k, t_odd);
+		}
+		else {
+			// (Tk, Tk+1) -> (T2k, T2k+1)
+			mpf_mul(t_k, t_k, t_k);
+			mpf_mul_2exp(t_k, t_k, 1);
+			mpf_sub_ui(t_k, t_k, 1);
+			mpf_swap(t_k1, t_odd);
+		}
+	}
+	mpf_set(result, t_k);
+}
+
+// Do the doubling iteration without counting the number of calculations.
+mpf_class chebyshev_doubling(mpf_class x, mpz_class n) {
+	chebyshev_workspace w(mpf_get_default_prec());
+	mpf_class result;
+	chebyshev_doubling_mpf(result.get_mpf_t(), x.get_mpf_t(), n.get_mpz_t(), w);
+	return result;
+}
+
+// Do the doubling iteration while counting the number of calculations.
+// Every bit of n computes 2 new terms (T2k or T2k+2, and T2k+1), so the count is 2 per bit of n.
+mpf_class chebyshev_doubling_count(mpf_class x, mpz_class n, mpz_class& count) {
+	if (n != 0) {
+		count += 2*mpz_sizeinbase(n.get_mpz_t(), 2);
+	}
+	return chebyshev_doubling(x, n);
+}
+
+
+
+/*------------------------------- Recoding of the Degree n -------------------------------*/
+
+
+// Plain binary: one digit 1 for every set bit of n.
+chebyshev_schedule schedule_binary(const mpz_class& n) {
+	return schedule_k_ary(n, 1);
+}
+
+// k-ary: the digits of n in base 2^k, from 1 to 2^k - 1.
+chebyshev_schedule schedule_k_ary(const mpz_class& n, int k) {
+	k = min(max(k, 1), SCHEDULE_MAX_WIDTH);
+	mpz_class abs_n = abs(n);
+	chebyshev_schedule schedule;
+	schedule.max_digit = (1 << k) - 1;
+	schedule.odd_digits = (k == 1);
+	if (abs_n == 0) {
+		return schedule;
+	}
+	mp_bitcnt_t len_bits = mpz_sizeinbase(abs_n.get_mpz_t(), 2);
+	mp_bitcnt_t windows_n = (len_bits + k - 1) / k;
+	for (mp_bitcnt_t i = windows_n; i-- > 0; ) {
+		int digit = 0;
+		for (int j = k - 1; j >= 0; j--) {
+			digit = 2*digit + mpz_tstbit(abs_n.get_mpz_t(), i*k + j);
+		}
+		if (digit != 0) {
+			schedule.positions.push_back(i*k);
+			schedule.digits.push_back(digit);
+		}
+	}
+	return schedule;
+}
+
+// Sliding window of width k: odd digits from 1 to 2^k - 1.
+// From the highest set bit i, the window is bits i..j, where j >= i-k+1 is the lowest set bit, so the digit is odd.
+chebyshev_schedule schedule_sliding_window(const mpz_class& n, int k) {
+	k = min(max(k, 1), SCHEDULE_MAX_WIDTH);
+	mpz_class abs_n = abs(n);
+	chebyshev_schedule schedule;
+	schedule.max_digit = (1 << k) - 1;
+	schedule.odd_digits = true;
+	if (abs_n == 0) {
+		return schedule;
+	}
+	long i = mpz_sizeinbase(abs_n.get_mpz_t(), 2) - 1;
+	while (i >= 0) {
+		if (!mpz_tstbit(abs_n.get_mpz_t(), i)) {
+			i--;
+			continue;
+		}
+		long j = max(i - k + 1, 0L);
+		while (!mpz_tstbit(abs_n.get_mpz_t(), j)) {
+			j++;
+		}
+		int digit = 0;
+		for (long b = i; b >= j; b--) {
+			digit = 2*digit + mpz_tstbit(abs_n.get_mpz_t(), b);
+		}
+		schedule.positions.push_back(j);
+		schedule.digits.push_back(digit);
+		i = j - 1;
+	}
+	return schedule;
+}
+
+// Width-w non-adjacent form, from low to high order: if n is odd, the digit is n mod 2^w taken in
+// (-2^(w-1), 2^(w-1)), and n - digit is divisible by 2^w, so the next w-1 digits are 0.
+chebyshev_schedule schedule_wnaf(const mpz_class& n, int w) {
+	w = min(max(w, 2), SCHEDULE_MAX_WIDTH);
+	mpz_class abs_n = abs(n);
+	chebyshev_schedule schedule;
+	schedule.max_digit = (1 << (w - 1)) - 1;
+	schedule.odd_digits = true;
+
+	mp_bitcnt_t position = 0;
+	while (abs_n != 0) {
+		if (mpz_odd_p(abs_n.get_mpz_t())) {
+			int digit = mpz_fdiv_ui(abs_n.get_mpz_t(), 1UL << w);
+			if (digit > schedule.max_digit) {
+				digit -= (1 << w);
+			}
+			abs_n -= digit;
+			schedule.positions.push_back(position);
+			schedule.digits.push_back(digit);
+		}
+		abs_n >>= 1;
+		position++;
+	}
+	reverse(schedule.positions.begin(), schedule.positions.end());
+	reverse(schedule.digits.begin(), schedule.digits.end());
+	return schedule;
+}
+
+// The number of multiplications by a table entry, the first digit is a copy.
+int schedule_multiplications(const chebyshev_schedule& schedule) {
+	return max(int(schedule.digits.size()) - 1, 0);
+}
+
+// The number of squarings is the position of the highest digit.
+mp_bitcnt_t schedule_squarings(const chebyshev_schedule& schedule) {
+	if (schedule.positions.empty()) {
+		return 0;
+	}
+	return schedule.positions[0];
+}
+
+
+
+/*------------------------------- Precision Context -------------------------------*/
+
+
+chebyshev_context::chebyshev_context(mp_bitcnt_t prec) : prec(prec), w(prec), mx(prec), power(prec) {
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < CHEBYSHEV_BATCH_TILE; j++) {
+			mpf_init2(batch[i][j], prec);
+		}
+	}
+}
+
+chebyshev_context::~chebyshev_context() {
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < CHEBYSHEV_BATCH_TILE; j++) {
+			mpf_clear(batch[i][j]);
+		}
+	}
+}
+
+// Return 0 at the precision of ctx.
+mpf_class context_mpf(const chebyshev_context& ctx) {
+	return mpf_class(0, ctx.prec);
+}
+
+// Return the decimal number str at the precision of ctx.
+mpf_class context_mpf(const chebyshev_context& ctx, string str) {
+	mpf_class x(0, ctx.prec);
+	x.set_str(str, 10);
+	return x;
+}
+
+// Expand the decimal parts into integers, with the temporaries at the precision of ctx.
+mpz_class expand_mpf_decimal(const chebyshev_context& ctx, mpf_class x, int n_digits) {
+	mpf_class tmp(0, ctx.prec);
+	// Important to notice the sign, it will be different to get the first integer number!
+	if (x > 0) {
+		tmp = floor(x);
+	}
+	else {
+		tmp = ceil(x);
+	}
+	while (x - floor(x) != 0) {
+		tmp *= 10;
+		x *= 10;
+	}
+	x = x - tmp;
+
+	mpz_class x_mpz;
+	mp_exp_t power = 0;
+	x_mpz.set_str(x.get_str(power, 10, digits2bit_mpf(n_digits)), 10);
+	return x_mpz;
+}
+
+// Get "floor(x)" + "." + "a", merge the .
+// The result gets the precision of the merged string (at least the one of ctx), but the default precision is not changed.
+mpf_class merge_integer_and_decimal(const chebyshev_context& ctx, mpf_class x, mpz_class a) {
+	mpf_class tmp1(0, x.get_prec());
+	// Important to notice the sign, it will be different to get the integer number!
+	if (x > 0) {
+		tmp1 = floor(x);
+	}
+	else {
+		tmp1 = ceil(x);
+	}
+	mp_exp_t power = 0;
+
+	string tmp_str = tmp1.get_str(power, 10, count_digits_mpf_integer(x));
+	tmp_str += ".";
+
+	// Avoid the situation of a is a negative number.
+	a = abs(a);
+	tmp_str += a.get_str();
+
+	mpf_class tmp2(0, max(ctx.prec, digits2bit_mpf(tmp_str.length())));
+	tmp2.set_str(tmp_str, 10);
+	return tmp2;
+}
+
+// Do the expensive iteration at the precision of ctx while counting the number of calculations.
+mpf_class chebyshev_expensive_count(chebyshev_context& ctx, const mpf_class& x, mpz_class s, mpz_class& count) {
+	if (s > 0) {
+		count += s;
+	}
+	return chebyshev_expensive(ctx, x, s);
+}
+
+// Do the expensive iteration at the precision of ctx without counting the number of calculations.
+mpf_class chebyshev_expensive(chebyshev_context& ctx, const mpf_class& x, mpz_class s) {
+	mpf_t& t_prev = ctx.w.t[0];
+	mpf_t& t_curr = ctx.w.t[1];
+	mpf_t& t_next = ctx.w.t[2];
+	mpf_t& two_x = ctx.w.p.a[0];
+	mpf_set_ui(t_prev, 1);
+	mpf_set(t_curr, x.get_mpf_t());
+	mpf_mul_2exp(two_x, x.get_mpf_t(), 1);
+	for (mpz_class i = 0; i < s; i++) {
+		mpf_mul(t_next, two_x, t_curr);
+		mpf_sub(t_next, t_next, t_prev);
+		mpf_swap(t_prev, t_curr);
+		mpf_swap(t_curr, t_next);
+	}
+	mpf_class result(0, ctx.prec);
+	mpf_set(result.get_mpf_t(), t_prev);
+	return result;
+}
+
+// Do the economical iteration at the precision of ctx while counting the number of calculations.
+mpf_class chebyshev_economical_count(chebyshev_context& ctx, const mpf_class& x, mpz_class n, mpz_class& count) {
+	count += chebyshev_economical_operations(n);
+	return chebyshev_economical(ctx, x, n);
+}
+
+// Do the economical iteration at the precision of ctx without counting the number of calculations.
+// This is the same algorithm as chebyshev_economical: for every set bit 2^k of n-1, rebuild Mx^(2^k) by k squarings
+// and multiply it into Mx, but the matrices are the ones of ctx and nothing is allocated.
+mpf_class chebyshev_economical(chebyshev_context& ctx, const mpf_class& x, mpz_class n) {
 	// This algorithm does one more in default, so we need to substract one of the number of iterations.
 	n = n - 1;
-	int len_n = count_digits_mpz(n);
-	int* binary_rep = binary_representation(n, len_n);
 
-	//After t*Mx, Tn-2(x) will be Tn-1(x), Tn-1(x) will be Tn(x),
-	//and Tn(x) will be 2xTn - Tn-1, which is Tn+1(x).
-	mpf_class* t = new mpf_class[4];
-	t[0] = 1;	//Tn-2(x), here is T0(x)
-	t[1] = x;	//Tn-1(x), here is T1(x)
-	t[2] = x;	//Tn-1(x), here is T1(x)
-	t[3] = 2*x - 1;	//Tn(x), here is T2(x)
+	matrix_mpf& Mx = ctx.mx;
+	matrix_mpf& tmp = ctx.power;
+	matrix_mpf_set_mx(Mx, x.get_mpf_t());
+	if (n > 0) {
+		// from high to low order of 2
+		for (mp_bitcnt_t i = mpz_sizeinbase(n.get_mpz_t(), 2); i-- > 0; ) {
+			if (mpz_tstbit(n.get_mpz_t(), i)) {
+				matrix_mpf_set_mx(tmp, x.get_mpf_t());
+				// 2^k, matrix power from opposite direction.
+				for (mp_bitcnt_t j = 0; j < i; j++) {
+					matrix_mpf_square(tmp);
+				}
+				matrix_mpf_multiplication(Mx, tmp);
+			}
+		}
+	}
 
-	// Compute Mx^(2^k1 + 2^k2 + 2^k3 + ... + 2^kn), then t*Mx since multiplication is
-	// associative, then t[0] will be changed from T0(x) to Tn(x).
-	mpf_class* Mx = new mpf_class[4];
-	Mx[0] = 0;
-	Mx[1] = -1;
-	Mx[2] = 1;
-	Mx[3] = 2*x;
+	// t*Mx, the first row of t is [T0(x), T1(x)], so Tn(x) = Mx0 + x*Mx2.
+	mpf_class result(0, ctx.prec);
+	mpf_mul(result.get_mpf_t(), x.get_mpf_t(), Mx.a[2]);
+	mpf_add(result.get_mpf_t(), result.get_mpf_t(), Mx.a[0]);
+	return result;
+}
 
-	// Need a tmp to store our original Mx every time.
-	mpf_class* tmp = new mpf_class[4];
-	for (int i = 0; i < 4*len_n; i++) {
-		if (binary_rep[i] == 1) {
-			tmp[0] = 0;
-			tmp[1] = -1;
-			tmp[2] = 1;
-			tmp[3] = 2*x;
-			// 2^k, matrix power from opposite direction.
-			for (int j = 0; j < 4*len_n - 1 - i; j++) {
-				tmp = matrix_multiplication(tmp, tmp);
+// Do the ladder iteration at the precision of ctx while counting the number of calculations.
+mpf_class chebyshev_ladder_count(chebyshev_context& ctx, const mpf_class& x, const mpz_class& n, mpz_class& count) {
+	count += chebyshev_economical_operations(n);
+	return chebyshev_ladder(ctx, x, n);
+}
+
+// Do the ladder iteration at the precision of ctx without counting the number of calculations.
+mpf_class chebyshev_ladder(chebyshev_context& ctx, const mpf_class& x, const mpz_class& n) {
+	mpf_class result(0, ctx.prec);
+	chebyshev_ladder_mpf(result.get_mpf_t(), x.get_mpf_t(), n.get_mpz_t(), ctx.w);
+	return result;
+}
+
+// Do the doubling iteration at the precision of ctx while counting the number of calculations.
+mpf_class chebyshev_doubling_count(chebyshev_context& ctx, const mpf_class& x, const mpz_class& n, mpz_class& count) {
+	if (n != 0) {
+		count += 2*mpz_sizeinbase(n.get_mpz_t(), 2);
+	}
+	return chebyshev_doubling(ctx, x, n);
+}
+
+// Do the doubling iteration at the precision of ctx without counting the number of calculations.
+mpf_class chebyshev_doubling(chebyshev_context& ctx, const mpf_class& x, const mpz_class& n) {
+	mpf_class result(0, ctx.prec);
+	chebyshev_doubling_mpf(result.get_mpf_t(), x.get_mpf_t(), n.get_mpz_t(), ctx.w);
+	return result;
+}
+
+
+
+/*------------------------------- Executor of a Schedule -------------------------------*/
+
+
+// Return Tn(x) at the precision of ctx, where n is given by its schedule.
+mpf_class chebyshev_scheduled(chebyshev_context& ctx, const mpf_class& x, const chebyshev_schedule& schedule) {
+	mpf_class result(0, ctx.prec);
+	if (schedule.digits.empty()) {
+		// T0(x) = 1
+		mpf_set_ui(result.get_mpf_t(), 1);
+		return result;
+	}
+
+	// table[d-1] = Mx^d, for the odd d only if the schedule has only odd digits.
+	int step = schedule.odd_digits ? 2 : 1;
+	vector<matrix_mpf*> table(schedule.max_digit, NULL);
+	matrix_mpf& Mx2 = ctx.power;
+	matrix_mpf_set_mx(Mx2, x.get_mpf_t());
+	matrix_mpf_square(Mx2);
+	for (int d = 1; d <= schedule.max_digit; d += step) {
+		table[d-1] = new matrix_mpf(ctx.prec);
+		if (d == 1) {
+			matrix_mpf_set_mx(*table[d-1], x.get_mpf_t());
+		}
+		else {
+			// Mx^d = Mx^(d-step) * Mx^step
+			matrix_mpf_set(*table[d-1], *table[d-1-step]);
+			if (step == 2) {
+				matrix_mpf_multiplication(*table[d-1], Mx2);
+			}
+			else {
+				matrix_mpf_multiplication(*table[d-1], *table[0]);
 			}
-			// If j == 4*len_n, the above does nothing and Mx = Mx*tmp, which is 2^0.
-			Mx = matrix_multiplication(Mx, tmp);
 		}
 	}
-	t = matrix_multiplication(t, Mx);
 
-	mpf_class result = t[0];
-	delete[] binary_rep;
-	delete[] tmp;
-	delete[] Mx;
-	delete[] t;
+	mpf_t& two_x = ctx.w.t[0];
+	mpf_mul_2exp(two_x, x.get_mpf_t(), 1);
+	matrix_mpf& acc = ctx.mx;
+	matrix_mpf& inverse = ctx.power;
+	for (int i = 0; i < schedule.digits.size(); i++) {
+		if (i > 0) {
+			for (mp_bitcnt_t j = schedule.positions[i]; j < schedule.positions[i-1]; j++) {
+				matrix_mpf_square(acc);
+			}
+		}
+		int digit = schedule.digits[i];
+		matrix_mpf* factor = table[abs(digit)-1];
+		if (digit < 0) {
+			// [a, b; c, d]^-1 = [d, -b; -c, a], since every power of Mx has determinant 1.
+			mpf_set(inverse.a[0], factor->a[3]);
+			mpf_neg(inverse.a[1], factor->a[1]);
+			mpf_neg(inverse.a[2], factor->a[2]);
+			mpf_set(inverse.a[3], factor->a[0]);
+			factor = &inverse;
+		}
+		if (i == 0) {
+			matrix_mpf_set(acc, *factor);
+		}
+		else if (digit == 1) {
+			matrix_mpf_multiplication_mx(acc, two_x);
+		}
+		else {
+			matrix_mpf_multiplication(acc, *factor);
+		}
+	}
+	for (mp_bitcnt_t j = 0; j < schedule.positions.back(); j++) {
+		matrix_mpf_square(acc);
+	}
+
+	for (int d = 0; d < table.size(); d++) {
+		delete table[d];
+	}
+
+	// Tn(x) = T0(x)*acc0 + T1(x)*acc2.
+	mpf_mul(result.get_mpf_t(), x.get_mpf_t(), acc.a[2]);
+	mpf_add(result.get_mpf_t(), result.get_mpf_t(), acc.a[0]);
+	return result;
+}
+
+
+
+/*------------------------------- Batch of Inputs with the same Degree -------------------------------*/
+
+
+// result_list[i] = Tn(x_list[i]) for the x_list_n inputs, all with the same n, at the precision of ctx.
+// The bits of n are decoded once into bits[], from high to low order, then we take the inputs by tiles of
+// CHEBYSHEV_BATCH_TILE, and every bit does the doubling step of chebyshev_doubling_mpf for the whole tile,
+// such that the multiplications of independent inputs follow each other and the tile stays in the cache.
+void chebyshev_batch(chebyshev_context& ctx, const mpf_class* x_list, int x_list_n, const mpz_class& n, mpf_class* result_list) {
+	// Tn(x) = T-n(x), since Tn(cos(a)) = cos(na).
+	mpz_t abs_n;
+	mpz_roinit_n(abs_n, mpz_limbs_read(n.get_mpz_t()), mpz_size(n.get_mpz_t()));
+	int len_bits = mpz_sgn(abs_n) == 0 ? 0 : mpz_sizeinbase(abs_n, 2);
+	int* bits = new int[len_bits];
+	for (int i = 0; i < len_bits; i++) {
+		bits[i] = mpz_tstbit(abs_n, len_bits - 1 - i);
+	}
+
+	mpf_t* t_k = ctx.batch[0];	//Tk(x)
+	mpf_t* t_k1 = ctx.batch[1];	//Tk+1(x)
+	mpf_t* t_odd = ctx.batch[2];	//T2k+1(x)
+	for (int first = 0; first < x_list_n; first += CHEBYSHEV_BATCH_TILE) {
+		int tile_n = min(CHEBYSHEV_BATCH_TILE, x_list_n - first);
+		const mpf_class* x = x_list + first;
+		for (int j = 0; j < tile_n; j++) {
+			mpf_set_ui(t_k[j], 1);
+			mpf_set(t_k1[j], x[j].get_mpf_t());
+		}
+
+		for (int i = 0; i < len_bits; i++) {
+			for (int j = 0; j < tile_n; j++) {
+				// T2k+1(x) = 2Tk(x)Tk+1(x) - x
+				mpf_mul(t_odd[j], t_k[j], t_k1[j]);
+				mpf_mul_2exp(t_odd[j], t_odd[j], 1);
+				mpf_sub(t_odd[j], t_odd[j], x[j].get_mpf_t());
+			}
+			if (bits[i] == 1) {
+				// (Tk, Tk+1) -> (T2k+1, T2k+2)
+				for (int j = 0; j < tile_n; j++) {
+					mpf_mul(t_k1[j], t_k1[j], t_k1[j]);
+					mpf_mul_2exp(t_k1[j], t_k1[j], 1);
+					mpf_sub_ui(t_k1[j], t_k1[j], 1);
+					mpf_swap(t_k[j], t_odd[j]);
+				}
+			}
+			else {
+				// (Tk, Tk+1) -> (T2k, T2k+1)
+				for (int j = 0; j < tile_n; j++) {
+					mpf_mul(t_k[j], t_k[j], t_k[j]);
+					mpf_mul_2exp(t_k[j], t_k[j], 1);
+					mpf_sub_ui(t_k[j], t_k[j], 1);
+					mpf_swap(t_k1[j], t_odd[j]);
+				}
+			}
+		}
+
+		for (int j = 0; j < tile_n; j++) {
+			result_list[first + j].set_prec(ctx.prec);
+			mpf_set(result_list[first + j].get_mpf_t(), t_k[j]);
+		}
+	}
+	delete[] bits;
+}
+
+
+
+/*------------------------------- Many Degrees with the same Base x -------------------------------*/
+
+
+chebyshev_power_cache::chebyshev_power_cache(const mpf_class& x, mp_bitcnt_t prec) : prec(prec), x(x, prec), acc(prec), n_squarings(0) {
+	// powers[0] = Mx
+	matrix_mpf* p = new matrix_mpf(prec);
+	matrix_mpf_set_mx(*p, this->x.get_mpf_t());
+	powers.push_back(p);
+}
+
+chebyshev_power_cache::~chebyshev_power_cache() {
+	for (int i = 0; i < powers.size(); i++) {
+		delete powers[i];
+	}
+}
+
+// Return Tn(x) for the x of cache, using and extending the cached powers Mx^(2^k).
+// Mx^n = Mx^(2^k1) * Mx^(2^k2) * ... for the set bits k1, k2, ... of n, and [T0(x), T1(x)] * Mx^n = [Tn(x), Tn+1(x)].
+mpf_class chebyshev_cached(chebyshev_power_cache& cache, const mpz_class& n) {
+	// Tn(x) = T-n(x), since Tn(cos(a)) = cos(na).
+	mpz_t abs_n;
+	mpz_roinit_n(abs_n, mpz_limbs_read(n.get_mpz_t()), mpz_size(n.get_mpz_t()));
+	mp_bitcnt_t len_bits = mpz_sgn(abs_n) == 0 ? 0 : mpz_sizeinbase(abs_n, 2);
+
+	// Only square the powers that no earlier degree needed.
+	while (cache.powers.size() < len_bits) {
+		matrix_mpf* p = new matrix_mpf(cache.prec);
+		matrix_mpf_set(*p, *cache.powers.back());
+		matrix_mpf_square(*p);
+		cache.powers.push_back(p);
+		cache.n_squarings++;
+	}
+
+	matrix_mpf_set_identity(cache.acc);
+	for (mp_bitcnt_t k = 0; k < len_bits; k++) {
+		if (mpz_tstbit(abs_n, k)) {
+			matrix_mpf_multiplication(cache.acc, *cache.powers[k]);
+		}
+	}
+
+	// Tn(x) = T0(x)*acc0 + T1(x)*acc2.
+	mpf_class result(0, cache.prec);
+	mpf_mul(result.get_mpf_t(), cache.x.get_mpf_t(), cache.acc.a[2]);
+	mpf_add(result.get_mpf_t(), result.get_mpf_t(), cache.acc.a[0]);
+	return result;
+}
+
+
+
+/*------------------------------- Fixed Base x with a Window Table -------------------------------*/
+
+
+// The number of bytes of the table of width window for degrees up to max_bits bits at precision prec.
+// Every matrix_mpf has 7 mpf_t, each of them with prec/64 + 2 limbs.
+size_t chebyshev_window_table_memory(mp_bitcnt_t prec, mp_bitcnt_t max_bits, int window) {
+	window = min(max(window, 1), WINDOW_MAX_WIDTH);
+	size_t windows_n = (max_bits + window - 1) / window;
+	size_t matrix_size = sizeof(matrix_mpf) + 7 * (prec / GMP_NUMB_BITS + 2) * sizeof(mp_limb_t);
+	return windows_n * ((size_t(1) << window) - 1) * matrix_size;
+}
+
+chebyshev_window_table::chebyshev_window_table(const mpf_class& x, mp_bitcnt_t prec, mp_bitcnt_t max_bits, int window, size_t memory_budget)
+		: prec(prec), x(x, prec), window(min(max(window, 1), WINDOW_MAX_WIDTH)), max_bits(max_bits), acc(prec), w(prec) {
+	while (this->window > 1 && chebyshev_window_table_memory(prec, max_bits, this->window) > memory_budget) {
+		this->window--;
+	}
+	int digits_n = (1 << this->window) - 1;
+	windows_n = (max_bits + this->window - 1) / this->window;
+
+	// base = Mx^(2^(w*i)) for the window i, then the window i+1 starts from Mx^((2^w - 1) * 2^(w*i)) * base.
+	matrix_mpf base(prec);
+	matrix_mpf_set_mx(base, this->x.get_mpf_t());
+	for (int i = 0; i < windows_n; i++) {
+		for (int j = 1; j <= digits_n; j++) {
+			matrix_mpf* p = new matrix_mpf(prec);
+			if (j == 1) {
+				matrix_mpf_set(*p, base);
+			}
+			else {
+				matrix_mpf_set(*p, *table.back());
+				matrix_mpf_multiplication(*p, base);
+			}
+			table.push_back(p);
+		}
+		matrix_mpf_multiplication(base, *table.back());
+	}
+}
+
+chebyshev_window_table::~chebyshev_window_table() {
+	for (int i = 0; i < table.size(); i++) {
+		delete table[i];
+	}
+}
+
+// Return Tn(x) for the fixed x of table.
+// Mx^n = PRODUCT(Mx^(d_i * 2^(w*i))) for the digits d_i of n in base 2^w, every factor is already in the table.
+mpf_class chebyshev_windowed(chebyshev_window_table& table, const mpz_class& n) {
+	// Tn(x) = T-n(x), since Tn(cos(a)) = cos(na).
+	mpz_t abs_n;
+	mpz_roinit_n(abs_n, mpz_limbs_read(n.get_mpz_t()), mpz_size(n.get_mpz_t()));
+	mpf_class result(0, table.prec);
+	if (mpz_sgn(abs_n) != 0 && mpz_sizeinbase(abs_n, 2) > table.max_bits) {
+		chebyshev_ladder_mpf(result.get_mpf_t(), table.x.get_mpf_t(), abs_n, table.w);
+		return result;
+	}
+
+	int digits_n = (1 << table.window) - 1;
+	matrix_mpf_set_identity(table.acc);
+	for (int i = 0; i < table.windows_n; i++) {
+		int digit = 0;
+		for (int j = table.window - 1; j >= 0; j--) {
+			digit = 2*digit + mpz_tstbit(abs_n, mp_bitcnt_t(i) * table.window + j);
+		}
+		if (digit != 0) {
+			matrix_mpf_multiplication(table.acc, *table.table[i * digits_n + digit - 1]);
+		}
+	}
 
+	// Tn(x) = T0(x)*acc0 + T1(x)*acc2.
+	mpf_mul(result.get_mpf_t(), table.x.get_mpf_t(), table.acc.a[2]);
+	mpf_add(result.get_mpf_t(), result.get_mpf_t(), table.acc.a[0]);
 	return result;
 }
 
 
 
+/*------------------------------- Decryption Session -------------------------------*/
+
+
+decryption_session::decryption_session(const mpz_class& s, mp_bitcnt_t prec, size_t capacity)
+		: s(s), ctx(prec), capacity(max(capacity, size_t(1))), hits(0), misses(0) {
+}
+
+// The exact bits of a: the sign and the number of limbs, the exponent, and the limbs without the zero ones at the bottom,
+// such that the same number gives the same key whatever its precision.
+string mpf_key(const mpf_class& a) {
+	const __mpf_struct* p = a.get_mpf_t();
+	const mp_limb_t* limbs = p->_mp_d;
+	long size = abs(p->_mp_size);
+	while (size > 0 && limbs[0] == 0) {
+		limbs++;
+		size--;
+	}
+	long header[2] = {p->_mp_size < 0 ? -size : size, p->_mp_exp};
+	string key((const char*)header, sizeof(header));
+	key.append((const char*)limbs, size * sizeof(mp_limb_t));
+	return key;
+}
+
+mpf_class session_reciprocal(decryption_session& session, const mpf_class& z0) {
+	string key = mpf_key(z0);
+	auto found = session.index.find(key);
+	if (found != session.index.end()) {
+		session.hits++;
+		session.entries.splice(session.entries.begin(), session.entries, found->second);
+		return found->second->second;
+	}
+	session.misses++;
+	if (session.entries.size() >= session.capacity) {
+		session.index.erase(session.entries.back().first);
+		session.entries.pop_back();
+	}
+	mpf_class reciprocal = context_mpf(session.ctx);
+	reciprocal = 1 / chebyshev_economical(session.ctx, z0, session.s);
+	session.entries.emplace_front(key, reciprocal);
+	session.index[key] = session.entries.begin();
+	return session.entries.front().second;
+}
+
+mpf_class session_decrypt(decryption_session& session, const mpf_class& z0, const mpf_class& z2) {
+	mpf_class u = context_mpf(session.ctx);
+	u = z2 * session_reciprocal(session, z0);
+	return u;
+}
+
+
+
 /*------------------------------- For Encryption Scheme - Block & Evp -------------------------------*/
 
 
@@ -388,6 +1205,296 @@ string binary_list_to_message(string* binary_list, int binary_list_n) {
 }
 
 
+// Convert the groups "0.0100..." of message_to_binary_list to floating numbers u at precision prec.
+mpf_class* binary_list_to_u_list(string* binary_list, int binary_list_n, mp_bitcnt_t prec) {
+	mpf_class* u_list = new mpf_class[binary_list_n];
+	for (int i = 0; i < binary_list_n; i++) {
+		u_list[i].set_prec(prec);
+		u_list[i].set_str(binary_list[i], 10);
+	}
+	return u_list;
+}
+
+// Convert the recovered u back to groups of at most 8*char_n_per_group binary digits for binary_list_to_message.
+string* u_list_to_binary_list(mpf_class* u_list, int u_list_n, int char_n_per_group) {
+	string* binary_list = new string[u_list_n];
+	mp_exp_t power;
+	for (int i = 0; i < u_list_n; i++) {
+		//get_str() returns an integer form string with an variable represent power.
+		//Example: "3.1415" -> "31415" with power = 1.
+		power = 0;
+		binary_list[i] = u_list[i].get_str(power, 10, char_n_per_group*8+2);
+		//Add missing 0's at the front.
+		for (int j = power; j < 0; j++) {
+			binary_list[i] = "0" + binary_list[i];
+		}
+		//Drop the 2 digits we took for the rounding.
+		if (binary_list[i].length() > char_n_per_group*8) {
+			binary_list[i].resize(char_n_per_group*8);
+		}
+		//Add the missing 0's at the end of floating numbers.
+		while (binary_list[i].length()%8 != 0) {
+			binary_list[i] += '0';
+		}
+	}
+	return binary_list;
+}
+
+int packed_bytes_per_group(int n_digits_l) {
+	// log2(10) = 3.3219...
+	return max(int((n_digits_l * 3.321928 - 1) / 8), 1);
+}
+
+mpf_class* message_to_packed_u_list(const string& message, int u_list_n, int byte_n_per_group, mp_bitcnt_t prec) {
+	mp_bitcnt_t bits = 8 * mp_bitcnt_t(byte_n_per_group);
+	mpf_class* u_list = new mpf_class[u_list_n];
+	string group(byte_n_per_group, '\0');
+	mpz_class tmp;
+	for (int i = 0; i < u_list_n; i++) {
+		size_t first = size_t(i) * byte_n_per_group;
+		group.assign(byte_n_per_group, '\0');
+		if (first < message.length()) {
+			message.copy(&group[0], byte_n_per_group, first);
+		}
+		// Most significant byte first, so the first char is the first byte after the point.
+		mpz_import(tmp.get_mpz_t(), byte_n_per_group, 1, 1, 0, 0, group.data());
+		u_list[i].set_prec(max(prec, bits));
+		mpf_set_z(u_list[i].get_mpf_t(), tmp.get_mpz_t());
+		mpf_div_2exp(u_list[i].get_mpf_t(), u_list[i].get_mpf_t(), bits);
+	}
+	return u_list;
+}
+
+string packed_u_list_to_message(mpf_class* u_list, int u_list_n, int byte_n_per_group) {
+	mp_bitcnt_t bits = 8 * mp_bitcnt_t(byte_n_per_group);
+	string message(size_t(u_list_n) * byte_n_per_group, '\0');
+	mpf_class scaled(0, max(u_list_n > 0 ? u_list[0].get_prec() : 64, bits + 64));
+	mpz_class tmp, top;
+	mpz_ui_pow_ui(top.get_mpz_t(), 2, bits);
+	top -= 1;
+	size_t count;
+	for (int i = 0; i < u_list_n; i++) {
+		mpf_mul_2exp(scaled.get_mpf_t(), u_list[i].get_mpf_t(), bits);
+		scaled += 0.5;
+		mpf_floor(scaled.get_mpf_t(), scaled.get_mpf_t());
+		tmp = scaled;
+		// A u recovered slightly out of [0, 1) stays in the byte range.
+		if (tmp < 0) {
+			tmp = 0;
+		}
+		if (tmp > top) {
+			tmp = top;
+		}
+		// mpz_export drops the leading zero bytes, so the bytes are written at the end of the group.
+		size_t size = (mpz_sizeinbase(tmp.get_mpz_t(), 2) + 7) / 8;
+		char* group = &message[size_t(i) * byte_n_per_group];
+		mpz_export(group + byte_n_per_group - size, &count, 1, 1, 0, 0, tmp.get_mpz_t());
+	}
+	return message;
+}
+
+
+/*------------------------------- Binary Format of Ciphertexts & Keys -------------------------------*/
+
+
+// Write the n_bytes low bytes of value, least significant first.
+void write_uint_binary(ostream& out, unsigned long long value, int n_bytes) {
+	char bytes[8];
+	for (int i = 0; i < n_bytes; i++) {
+		bytes[i] = char((value >> (8*i)) & 0xff);
+	}
+	out.write(bytes, n_bytes);
+}
+
+bool read_uint_binary(istream& in, unsigned long long& value, int n_bytes) {
+	unsigned char bytes[8];
+	if (!in.read((char*)bytes, n_bytes)) {
+		return false;
+	}
+	value = 0;
+	for (int i = 0; i < n_bytes; i++) {
+		value |= (unsigned long long)(bytes[i]) << (8*i);
+	}
+	return true;
+}
+
+void write_header_binary(ostream& out, const chebyshev_file_header& header) {
+	out.write("CHEB", 4);
+	write_uint_binary(out, header.version, 1);
+	write_uint_binary(out, header.kind, 1);
+	write_uint_binary(out, header.packing, 1);
+	write_uint_binary(out, 0, 1);
+	write_uint_binary(out, header.prec, 8);
+	write_uint_binary(out, header.blocks_n, 8);
+	write_uint_binary(out, header.group_n, 4);
+	write_uint_binary(out, header.bytes_n, 8);
+}
+
+bool read_header_binary(istream& in, chebyshev_file_header& header) {
+	char magic[4];
+	unsigned long long version, kind, packing, reserved, prec, group_n;
+	if (!in.read(magic, 4) || string(magic, 4) != "CHEB") {
+		return false;
+	}
+	if (!read_uint_binary(in, version, 1) || !read_uint_binary(in, kind, 1) || !read_uint_binary(in, packing, 1)
+			|| !read_uint_binary(in, reserved, 1) || !read_uint_binary(in, prec, 8) || !read_uint_binary(in, header.blocks_n, 8)
+			|| !read_uint_binary(in, group_n, 4) || !read_uint_binary(in, header.bytes_n, 8)) {
+		return false;
+	}
+	header.version = int(version);
+	header.kind = int(kind);
+	header.packing = int(packing);
+	header.prec = prec;
+	header.group_n = int(group_n);
+	return version == CHEBYSHEV_FORMAT_VERSION && prec > 0;
+}
+
+// Write sign * M * 2^shift, where M is given by its limbs.
+void write_scaled_binary(ostream& out, long long shift, int sign, const mpz_t m) {
+	size_t words_n = (mpz_sizeinbase(m, 2) + 63) / 64;
+	if (mpz_sgn(m) == 0) {
+		words_n = 0;
+	}
+	write_uint_binary(out, (unsigned long long)shift, 8);
+	write_uint_binary(out, sign < 0 ? 1 : 0, 1);
+	write_uint_binary(out, words_n, 4);
+	string words(words_n * 8, '\0');
+	size_t count;
+	// Words of 8 bytes, least significant word first, little-endian bytes: the same file on every machine.
+	mpz_export(&words[0], &count, -1, 8, -1, 0, m);
+	out.write(words.data(), words.length());
+}
+
+// Read a number of write_scaled_binary with at most words_max words, such that a hostile count is not allocated.
+bool read_scaled_binary(istream& in, long long& shift, int& sign, mpz_t m, unsigned long long words_max) {
+	unsigned long long shift_bits, negative, words_n;
+	if (!read_uint_binary(in, shift_bits, 8) || !read_uint_binary(in, negative, 1) || !read_uint_binary(in, words_n, 4)
+			|| negative > 1 || words_n > words_max) {
+		return false;
+	}
+	string words(words_n * 8, '\0');
+	if (!in.read(&words[0], words.length())) {
+		return false;
+	}
+	mpz_import(m, words_n, -1, 8, -1, 0, words.data());
+	shift = (long long)shift_bits;
+	sign = negative ? -1 : 1;
+	return true;
+}
+
+void write_mpf_binary(ostream& out, const mpf_class& a) {
+	// The limbs of a are its mantissa M, and a = M * 2^(GMP_NUMB_BITS*(exp - size)).
+	const __mpf_struct* p = a.get_mpf_t();
+	int size = abs(p->_mp_size);
+	mpz_t m;
+	mpz_roinit_n(m, p->_mp_d, size);
+	write_scaled_binary(out, (long long)(p->_mp_exp - size) * GMP_NUMB_BITS, p->_mp_size, m);
+}
+
+bool read_mpf_binary(istream& in, mpf_class& a, mp_bitcnt_t prec) {
+	long long shift;
+	int sign;
+	mpz_class m;
+	// An mpf of prec bits has at most prec/GMP_NUMB_BITS + 3 limbs, which is at most prec/64 + 3 words of 64 bits.
+	if (!read_scaled_binary(in, shift, sign, m.get_mpz_t(), prec / 64 + 3)) {
+		return false;
+	}
+	a.set_prec(prec);
+	mpf_set_z(a.get_mpf_t(), m.get_mpz_t());
+	if (shift >= 0) {
+		mpf_mul_2exp(a.get_mpf_t(), a.get_mpf_t(), shift);
+	}
+	else {
+		mpf_div_2exp(a.get_mpf_t(), a.get_mpf_t(), -shift);
+	}
+	if (sign < 0) {
+		a = -a;
+	}
+	return true;
+}
+
+void write_mpz_binary(ostream& out, const mpz_class& a) {
+	mpz_class m = abs(a);
+	write_scaled_binary(out, 0, sgn(a), m.get_mpz_t());
+}
+
+bool read_mpz_binary(istream& in, mpz_class& a, mp_bitcnt_t bits) {
+	long long shift;
+	int sign;
+	if (!read_scaled_binary(in, shift, sign, a.get_mpz_t(), bits / 64 + 1) || shift != 0) {
+		return false;
+	}
+	if (sign < 0) {
+		a = -a;
+	}
+	return true;
+}
+
+void write_ciphertext_binary(ostream& out, chebyshev_file_header header, const mpf_class* z0_list, const mpf_class* z2_list) {
+	header.version = CHEBYSHEV_FORMAT_VERSION;
+	header.kind = FILE_CIPHERTEXT;
+	write_header_binary(out, header);
+	for (unsigned long long i = 0; i < header.blocks_n; i++) {
+		write_mpf_binary(out, z0_list[i]);
+		write_mpf_binary(out, z2_list[i]);
+	}
+}
+
+bool read_ciphertext_binary(istream& in, chebyshev_file_header& header, mpf_class*& z0_list, mpf_class*& z2_list) {
+	z0_list = NULL;
+	z2_list = NULL;
+	if (!read_header_binary(in, header) || header.kind != FILE_CIPHERTEXT) {
+		return false;
+	}
+	// blocks_n is not trusted: the numbers grow as they are read, so a truncated file fails at its end instead of
+	// allocating blocks_n numbers first.
+	vector<mpf_class> z0_read, z2_read;
+	mpf_class z0, z2;
+	for (unsigned long long i = 0; i < header.blocks_n; i++) {
+		if (!read_mpf_binary(in, z0, header.prec) || !read_mpf_binary(in, z2, header.prec)) {
+			return false;
+		}
+		z0_read.push_back(z0);
+		z2_read.push_back(z2);
+	}
+	z0_list = new mpf_class[header.blocks_n];
+	z2_list = new mpf_class[header.blocks_n];
+	for (unsigned long long i = 0; i < header.blocks_n; i++) {
+		mpf_swap(z0_list[i].get_mpf_t(), z0_read[i].get_mpf_t());
+		mpf_swap(z2_list[i].get_mpf_t(), z2_read[i].get_mpf_t());
+	}
+	return true;
+}
+
+void write_public_key_binary(ostream& out, mp_bitcnt_t prec, const mpf_class& x, const mpf_class& y) {
+	chebyshev_file_header header = {CHEBYSHEV_FORMAT_VERSION, FILE_PUBLIC_KEY, 0, prec, 1, 0, 0};
+	write_header_binary(out, header);
+	write_mpf_binary(out, x);
+	write_mpf_binary(out, y);
+}
+
+bool read_public_key_binary(istream& in, mp_bitcnt_t& prec, mpf_class& x, mpf_class& y) {
+	chebyshev_file_header header;
+	if (!read_header_binary(in, header) || header.kind != FILE_PUBLIC_KEY || header.blocks_n == 0) {
+		return false;
+	}
+	prec = header.prec;
+	return read_mpf_binary(in, x, prec) && read_mpf_binary(in, y, prec);
+}
+
+void write_private_key_binary(ostream& out, const mpz_class& s) {
+	chebyshev_file_header header = {CHEBYSHEV_FORMAT_VERSION, FILE_PRIVATE_KEY, 0, mpz_sizeinbase(s.get_mpz_t(), 2), 1, 0, 0};
+	write_header_binary(out, header);
+	write_mpz_binary(out, s);
+}
+
+bool read_private_key_binary(istream& in, mpz_class& s) {
+	chebyshev_file_header header;
+	if (!read_header_binary(in, header) || header.kind != FILE_PRIVATE_KEY || header.blocks_n == 0) {
+		return false;
+	}
+	return read_mpz_binary(in, s, header.prec);
+}
 
 /*----------------------------- Extended Euclidean Algorithm and Modular Inverse for Bergamo's Attack ------------------------------*/
 
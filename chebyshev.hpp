@@ -2,9 +2,16 @@
 // Date: September 2024
 
 // This Program is the Library of our Chebyshev Article
+#ifndef CHEBYSHEV_HPP
+#define CHEBYSHEV_HPP
+
 #include <iostream>
 #include <string>
 #include <bitset>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <cstdint>
 
 #include <gmpxx.h>
 #include <mpreal.h>
@@ -49,6 +56,40 @@ mpfr::mpreal mod_mpreal(mpfr::mpreal a, mpfr::mpreal b);
 /*------------------------------- Chebyshev Expensive & Economical Algorithm -------------------------------*/
 
 
+// The instrumentation policies of chebyshev_expensive_policy and chebyshev_economical_policy.
+// The iteration calls step() for one step 2x*Tn - Tn-1 of the expensive method, square() for one product tmp*tmp
+// and multiply() for one product u*v of matrix_multiplication. The methods are inline, so count_none costs nothing.
+struct count_none {
+	void step() {}
+	void square() {}
+	void multiply() {}
+};
+
+// The number of calculations of our term, as the _count functions report it: 1 per step, 2 per matrix product.
+struct count_total {
+	uint64_t calculations = 0;
+
+	void step() { calculations += 1; }
+	void square() { calculations += 2; }
+	void multiply() { calculations += 2; }
+};
+
+// The mpf operations: a step is 1 multiplication and 1 subtraction (the doubling 2x is not counted),
+// tmp*tmp is 2 squarings, 6 multiplications and 4 additions, u*v is 8 multiplications and 4 additions.
+struct count_detailed {
+	uint64_t squarings = 0;
+	uint64_t multiplications = 0;
+	uint64_t additions = 0;
+
+	void step() { multiplications += 1; additions += 1; }
+	void square() { squarings += 2; multiplications += 6; additions += 4; }
+	void multiply() { multiplications += 8; additions += 4; }
+};
+
+// Do the expensive iteration, reporting every step to policy (count_none, count_total or count_detailed).
+template <class Policy>
+mpf_class chebyshev_expensive_policy(const mpf_class& x, const mpz_class& s, Policy& policy);
+
 // Do the expensive iteration while counting the number of calculations.
 mpf_class chebyshev_expensive_count(mpf_class x, mpz_class s, mpz_class& count);
 
@@ -61,12 +102,277 @@ mpf_class* matrix_multiplication(mpf_class* u, mpf_class* v);
 
 mpf_class* matrix_power(mpf_class* u, mpz_class n);
 
+// A 2x2 matrix [a0, a1; a2, a3] on mpf_t, living on the stack with its own scratch.
+// The limbs are allocated once in the constructor, the kernels below work in place and never allocate.
+struct matrix_mpf {
+	mpf_t a[4];
+	mpf_t scratch[3];
+
+	matrix_mpf(mp_bitcnt_t prec);
+	~matrix_mpf();
+	matrix_mpf(const matrix_mpf&) = delete;
+	matrix_mpf& operator=(const matrix_mpf&) = delete;
+};
+
+void matrix_mpf_set(matrix_mpf& u, const matrix_mpf& v);
+
+void matrix_mpf_set_identity(matrix_mpf& u);
+
+// u = Mx = [0, -1; 1, 2x]
+void matrix_mpf_set_mx(matrix_mpf& u, const mpf_t x);
+
+// u = u*v, in place.
+void matrix_mpf_multiplication(matrix_mpf& u, const matrix_mpf& v);
+
+// u = u*u, in place, 5 multiplications.
+void matrix_mpf_square(matrix_mpf& u);
+
+// u = u*Mx, in place, 2 multiplications, where two_x = 2x.
+void matrix_mpf_multiplication_mx(matrix_mpf& u, const mpf_t two_x);
+
+// The temporaries of chebyshev_ladder_mpf and chebyshev_doubling_mpf at one precision.
+// Keep one alive and reuse it, then an evaluation does no heap allocation at all.
+struct chebyshev_workspace {
+	matrix_mpf p;
+	mpf_t t[3];
+
+	chebyshev_workspace(mp_bitcnt_t prec);
+	~chebyshev_workspace();
+	chebyshev_workspace(const chebyshev_workspace&) = delete;
+	chebyshev_workspace& operator=(const chebyshev_workspace&) = delete;
+};
+
+// Do the economical iteration, reporting every matrix product to policy (count_none, count_total or count_detailed).
+template <class Policy>
+mpf_class chebyshev_economical_policy(const mpf_class& x, mpz_class n, Policy& policy);
+
 // Do the economical iteration while counting the number of calculations.
 mpf_class chebyshev_economical_count(mpf_class x, mpz_class n, mpz_class& count);
 
 // Do the economical iteration without counting the number of calculations.
 mpf_class chebyshev_economical(mpf_class x, mpz_class n);
 
+// The number of calculations chebyshev_economical_count reports for Tn(x), without doing the iteration.
+mpz_class chebyshev_economical_operations(mpz_class n);
+
+// Do the ladder iteration while counting the number of calculations (same count as the economical method).
+mpf_class chebyshev_ladder_count(mpf_class x, mpz_class n, mpz_class& count);
+
+// Do the ladder iteration without counting the number of calculations, one pass over the bits of n.
+mpf_class chebyshev_ladder(mpf_class x, mpz_class n);
+
+// result = Tn(x) by the ladder iteration, without heap allocation, all temporaries are in w.
+void chebyshev_ladder_mpf(mpf_t result, const mpf_t x, const mpz_t n, chebyshev_workspace& w);
+
+// Do the doubling iteration without counting the number of calculations, 2 multiplications per bit of n.
+mpf_class chebyshev_doubling(mpf_class x, mpz_class n);
+
+// result = Tn(x) by the doubling iteration, without heap allocation, all temporaries are in w.
+void chebyshev_doubling_mpf(mpf_t result, const mpf_t x, const mpz_t n, chebyshev_workspace& w);
+
+// Do the doubling iteration while counting the number of calculations.
+mpf_class chebyshev_doubling_count(mpf_class x, mpz_class n, mpz_class& count);
+
+
+/*------------------------------- Recoding of the Degree n -------------------------------*/
+
+
+// A schedule of n = SUM(digits[i] * 2^positions[i]), with positions from high to low order and no zero digit.
+// chebyshev_scheduled starts from Mx^digits[0], then for every next term it squares positions[i-1] - positions[i]
+// times and multiplies by Mx^digits[i], and at last squares positions.back() times.
+// A negative digit multiplies by the inverse Mx^-d, which is free since det(Mx) = 1: Mx^-1 = [2x, 1; -1, 0].
+struct chebyshev_schedule {
+	vector<mp_bitcnt_t> positions;
+	vector<int> digits;
+	// The table of the executor holds Mx^d for every 1 <= d <= max_digit, or only the odd d if odd_digits.
+	int max_digit;
+	bool odd_digits;
+};
+
+// The largest width of a schedule: chebyshev_scheduled builds a table of up to 2^width - 1 matrices.
+#define SCHEDULE_MAX_WIDTH 16
+
+// Plain binary: one digit 1 for every set bit of n.
+chebyshev_schedule schedule_binary(const mpz_class& n);
+
+// k-ary: the digits of n in base 2^k, from 1 to 2^k - 1. k is clamped to 1..SCHEDULE_MAX_WIDTH.
+chebyshev_schedule schedule_k_ary(const mpz_class& n, int k);
+
+// Sliding window of width k: odd digits from 1 to 2^k - 1, the zeros between windows cost no multiplication.
+// k is clamped to 1..SCHEDULE_MAX_WIDTH.
+chebyshev_schedule schedule_sliding_window(const mpz_class& n, int k);
+
+// Width-w non-adjacent form: odd digits from -(2^(w-1) - 1) to 2^(w-1) - 1, at most one non-zero digit in w bits.
+// w is clamped to 2..SCHEDULE_MAX_WIDTH: with w = 1 there is no digit but 0.
+chebyshev_schedule schedule_wnaf(const mpz_class& n, int w);
+
+// The number of multiplications by a table entry, and the number of squarings of the schedule.
+int schedule_multiplications(const chebyshev_schedule& schedule);
+mp_bitcnt_t schedule_squarings(const chebyshev_schedule& schedule);
+
+
+/*------------------------------- Precision Context -------------------------------*/
+
+
+// chebyshev_batch moves this many inputs through the bits of n together, such that their limbs stay in the cache.
+#define CHEBYSHEV_BATCH_TILE 16
+
+// Everything a computation needs at one precision: the number of bits, and the temporaries of the evaluations.
+// Pass it to the functions below instead of calling mpf_set_default_prec, such that threads with different (l, m)
+// can share a process, and nothing is re-allocated when we switch between the l phase and the m phase.
+// One context must not be used by two threads at the same time, give every thread its own.
+struct chebyshev_context {
+	mp_bitcnt_t prec;
+	chebyshev_workspace w;
+	matrix_mpf mx;
+	matrix_mpf power;
+	// The pairs (Tk, Tk+1) and T2k+1 of one tile of chebyshev_batch.
+	mpf_t batch[3][CHEBYSHEV_BATCH_TILE];
+
+	chebyshev_context(mp_bitcnt_t prec);
+	~chebyshev_context();
+	chebyshev_context(const chebyshev_context&) = delete;
+	chebyshev_context& operator=(const chebyshev_context&) = delete;
+};
+
+// Return 0 at the precision of ctx.
+mpf_class context_mpf(const chebyshev_context& ctx);
+
+// Return the decimal number str at the precision of ctx.
+mpf_class context_mpf(const chebyshev_context& ctx, string str);
+
+// Expand the decimal parts into integers, with the temporaries at the precision of ctx.
+mpz_class expand_mpf_decimal(const chebyshev_context& ctx, mpf_class x, int n_digits);
+
+// Get "floor(x)" + "." + "a" without changing the default precision, at least at the precision of ctx.
+mpf_class merge_integer_and_decimal(const chebyshev_context& ctx, mpf_class x, mpz_class a);
+
+// Do the expensive iteration at the precision of ctx while counting the number of calculations.
+mpf_class chebyshev_expensive_count(chebyshev_context& ctx, const mpf_class& x, mpz_class s, mpz_class& count);
+
+// Do the expensive iteration at the precision of ctx without counting the number of calculations.
+mpf_class chebyshev_expensive(chebyshev_context& ctx, const mpf_class& x, mpz_class s);
+
+// Do the economical iteration at the precision of ctx while counting the number of calculations.
+mpf_class chebyshev_economical_count(chebyshev_context& ctx, const mpf_class& x, mpz_class n, mpz_class& count);
+
+// Do the economical iteration at the precision of ctx without counting the number of calculations.
+mpf_class chebyshev_economical(chebyshev_context& ctx, const mpf_class& x, mpz_class n);
+
+// Do the ladder iteration at the precision of ctx while counting the number of calculations.
+mpf_class chebyshev_ladder_count(chebyshev_context& ctx, const mpf_class& x, const mpz_class& n, mpz_class& count);
+
+// Do the ladder iteration at the precision of ctx without counting the number of calculations.
+mpf_class chebyshev_ladder(chebyshev_context& ctx, const mpf_class& x, const mpz_class& n);
+
+// Do the doubling iteration at the precision of ctx while counting the number of calculations.
+mpf_class chebyshev_doubling_count(chebyshev_context& ctx, const mpf_class& x, const mpz_class& n, mpz_class& count);
+
+// Do the doubling iteration at the precision of ctx without counting the number of calculations.
+mpf_class chebyshev_doubling(chebyshev_context& ctx, const mpf_class& x, const mpz_class& n);
+
+// Return Tn(x) at the precision of ctx, where n is given by its schedule.
+// The table of Mx^d is built for the schedule, which costs about max_digit (or max_digit/2 if odd_digits) multiplications.
+mpf_class chebyshev_scheduled(chebyshev_context& ctx, const mpf_class& x, const chebyshev_schedule& schedule);
+
+// result_list[i] = Tn(x_list[i]) for the x_list_n inputs, all with the same n, at the precision of ctx.
+// The bits of n are decoded only once, and the inputs go through the doubling iteration together.
+void chebyshev_batch(chebyshev_context& ctx, const mpf_class* x_list, int x_list_n, const mpz_class& n, mpf_class* result_list);
+
+
+/*------------------------------- Many Degrees with the same Base x -------------------------------*/
+
+
+// An evaluator of Tn(x) for one fixed x and any n, which keeps the powers Mx^(2^k) it has computed.
+// powers[k] = Mx^(2^k) is computed only once, the first time a degree with k+1 bits asks for it,
+// so a sweep over many degrees does the squarings only for the bits no earlier degree had.
+struct chebyshev_power_cache {
+	mp_bitcnt_t prec;
+	mpf_class x;
+	vector<matrix_mpf*> powers;
+	matrix_mpf acc;
+	// The number of squarings done so far, which is the number of cached powers minus one.
+	unsigned long n_squarings;
+
+	chebyshev_power_cache(const mpf_class& x, mp_bitcnt_t prec);
+	~chebyshev_power_cache();
+	chebyshev_power_cache(const chebyshev_power_cache&) = delete;
+	chebyshev_power_cache& operator=(const chebyshev_power_cache&) = delete;
+};
+
+// Return Tn(x) for the x of cache, using and extending the cached powers Mx^(2^k).
+mpf_class chebyshev_cached(chebyshev_power_cache& cache, const mpz_class& n);
+
+
+/*------------------------------- Fixed Base x with a Window Table -------------------------------*/
+
+
+// The largest width of a window table.
+#define WINDOW_MAX_WIDTH 24
+
+// A precomputed table for one fixed base x (the x or the y = Ts(x) of a public key), for degrees up to max_bits bits.
+// The bits of n are cut into windows of width w, and table[i*(2^w - 1) + j - 1] = Mx^(j * 2^(w*i)) for 1 <= j < 2^w,
+// such that Tn(x) needs one multiplication per non-zero window, about log2(n)/w, and no squaring at all.
+// If the table of width w needs more than memory_budget bytes, the width is reduced until it fits.
+// The width is clamped to 1..WINDOW_MAX_WIDTH.
+struct chebyshev_window_table {
+	mp_bitcnt_t prec;
+	mpf_class x;
+	int window;
+	int windows_n;
+	mp_bitcnt_t max_bits;
+	vector<matrix_mpf*> table;
+	matrix_mpf acc;
+	// Degrees with more than max_bits bits use the ladder iteration with this workspace.
+	chebyshev_workspace w;
+
+	chebyshev_window_table(const mpf_class& x, mp_bitcnt_t prec, mp_bitcnt_t max_bits, int window, size_t memory_budget);
+	~chebyshev_window_table();
+	chebyshev_window_table(const chebyshev_window_table&) = delete;
+	chebyshev_window_table& operator=(const chebyshev_window_table&) = delete;
+};
+
+// The number of bytes of the table of width window for degrees up to max_bits bits at precision prec.
+// A width out of 1..WINDOW_MAX_WIDTH is clamped as the table does.
+size_t chebyshev_window_table_memory(mp_bitcnt_t prec, mp_bitcnt_t max_bits, int window);
+
+// Return Tn(x) for the fixed x of table.
+mpf_class chebyshev_windowed(chebyshev_window_table& table, const mpz_class& n);
+
+
+/*------------------------------- Decryption Session -------------------------------*/
+
+
+// The number of z0 a decryption session keeps by default.
+#define DECRYPTION_CACHE_ENTRIES 64
+
+// The private key s and the precision of decryption, with a cache of 1/Ts(z0) for the last z0 seen.
+// All the blocks of a message of chebyshev_encryption_block share their z0, and a sender may reuse a ciphertext header,
+// so the evaluation of Ts(z0), the whole cost of a decryption, is done once per z0, and a block is one multiplication.
+// The cache is keyed by the exact bits of z0 (the limbs and the exponent), holds at most capacity entries, and drops
+// the least recently used one when it is full. One session must not be used by two threads at the same time.
+struct decryption_session {
+	mpz_class s;
+	chebyshev_context ctx;
+	size_t capacity;
+	// The most recently used first, and the position of every key in it.
+	list<pair<string, mpf_class>> entries;
+	unordered_map<string, list<pair<string, mpf_class>>::iterator> index;
+	unsigned long long hits;
+	unsigned long long misses;
+
+	decryption_session(const mpz_class& s, mp_bitcnt_t prec, size_t capacity = DECRYPTION_CACHE_ENTRIES);
+	decryption_session(const decryption_session&) = delete;
+	decryption_session& operator=(const decryption_session&) = delete;
+};
+
+// Return 1/Ts(z0) at the precision of session by the economical method, from the cache if z0 was seen.
+// It is a copy, as the next call may drop the entry from the cache.
+mpf_class session_reciprocal(decryption_session& session, const mpf_class& z0);
+
+// Return u = z2/Ts(z0) = z2 * (1/Ts(z0)).
+mpf_class session_decrypt(decryption_session& session, const mpf_class& z0, const mpf_class& z2);
+
 
 /*------------------------------- For Encryption Scheme - Block & Evp -------------------------------*/
 /*------------------------------- ASCII and Binary Manipulation -------------------------------*/
@@ -82,6 +388,93 @@ string* message_to_binary_list(string message, int binary_list_n, int char_n_per
 
 string binary_list_to_message(string* binary_list, int binary_list_n);
 
+// Convert the groups "0.0100..." of message_to_binary_list to floating numbers u at precision prec.
+mpf_class* binary_list_to_u_list(string* binary_list, int binary_list_n, mp_bitcnt_t prec);
+
+// Convert the recovered u back to groups of at most 8*char_n_per_group binary digits for binary_list_to_message.
+string* u_list_to_binary_list(mpf_class* u_list, int u_list_n, int char_n_per_group);
+
+// The ways to put the bytes of a message in the plaintexts u:
+// PACKING_DECIMAL is message_to_binary_list, 8 decimal digits "0"/"1" per byte, and PACKING_BINARY is message_to_packed_u_list.
+enum plaintext_packing {PACKING_DECIMAL = 0, PACKING_BINARY = 1};
+
+// Packed plaintext: the bytes of a group are the binary digits of u = (b_0 b_1 ... b_(k-1))_256 / 256^k,
+// so one byte takes 8 bits of the mantissa instead of 8 decimal digits.
+// The number k of bytes per group that precision l (in decimal digits) can recover: (l*log2(10) - 1) / 8.
+int packed_bytes_per_group(int n_digits_l);
+
+// Import the bytes of message into u_list_n floating numbers with mpz_import, byte_n_per_group bytes per group,
+// at the precision prec (at least 8*byte_n_per_group bits). The last group is padded with zero bytes.
+mpf_class* message_to_packed_u_list(const string& message, int u_list_n, int byte_n_per_group, mp_bitcnt_t prec);
+
+// Round every recovered u to the nearest multiple of 256^-byte_n_per_group and export its bytes with mpz_export.
+// The message has u_list_n*byte_n_per_group bytes, with the zero bytes padding the last group.
+string packed_u_list_to_message(mpf_class* u_list, int u_list_n, int byte_n_per_group);
+
+
+/*------------------------------- Binary Format of Ciphertexts & Keys -------------------------------*/
+
+
+// A file is a header and then its numbers. The header (all integers little-endian) is:
+// "CHEB", version (1 byte), kind (1 byte), packing (1 byte), 0 (1 byte), prec (8 bytes), blocks_n (8 bytes),
+// group_n (4 bytes), bytes_n (8 bytes).
+// A ciphertext has blocks_n pairs (z0, z2) of a message of bytes_n bytes, group_n bytes per block packed by packing,
+// a public key file has blocks_n pairs (x, Ts(x)) at the precision prec, a private key file has blocks_n integers s
+// of at most prec bits, and a calibration file has blocks_n records of chebyshev_calibration.hpp.
+// An mpf is written exactly as sign * M * 2^shift: shift (8 bytes, signed), sign (1 byte), the number of
+// 64-bit words of M (4 bytes), and the words of M from the least significant one (mpz_export).
+// An mpz is written the same way with shift = 0.
+#define CHEBYSHEV_FORMAT_VERSION 1
+
+enum chebyshev_file_kind {FILE_CIPHERTEXT = 1, FILE_PUBLIC_KEY = 2, FILE_PRIVATE_KEY = 3, FILE_CALIBRATION = 4};
+
+struct chebyshev_file_header {
+	int version;
+	int kind;
+	int packing;
+	mp_bitcnt_t prec;
+	unsigned long long blocks_n;
+	int group_n;
+	unsigned long long bytes_n;
+};
+
+// Write the n_bytes low bytes of value, least significant first.
+void write_uint_binary(ostream& out, unsigned long long value, int n_bytes);
+
+bool read_uint_binary(istream& in, unsigned long long& value, int n_bytes);
+
+void write_header_binary(ostream& out, const chebyshev_file_header& header);
+
+// Return false if in does not start with a header of this version.
+bool read_header_binary(istream& in, chebyshev_file_header& header);
+
+void write_mpf_binary(ostream& out, const mpf_class& a);
+
+// Read a number of write_mpf_binary into a at the precision prec. Return false on a truncated or malformed number.
+bool read_mpf_binary(istream& in, mpf_class& a, mp_bitcnt_t prec);
+
+void write_mpz_binary(ostream& out, const mpz_class& a);
+
+// Read a number of write_mpz_binary of at most bits bits (rounded up to 64-bit words).
+bool read_mpz_binary(istream& in, mpz_class& a, mp_bitcnt_t bits);
+
+// Write the header, with kind FILE_CIPHERTEXT, and the header.blocks_n pairs (z0_list[i], z2_list[i]).
+void write_ciphertext_binary(ostream& out, chebyshev_file_header header, const mpf_class* z0_list, const mpf_class* z2_list);
+
+// Read a ciphertext into new arrays z0_list and z2_list of header.blocks_n numbers. Return false if it is malformed
+// or shorter than its header says.
+bool read_ciphertext_binary(istream& in, chebyshev_file_header& header, mpf_class*& z0_list, mpf_class*& z2_list);
+
+// Write a public key file with the one key (x, y = Ts(x)) at the precision prec.
+void write_public_key_binary(ostream& out, mp_bitcnt_t prec, const mpf_class& x, const mpf_class& y);
+
+// Read the first key of a public key file.
+bool read_public_key_binary(istream& in, mp_bitcnt_t& prec, mpf_class& x, mpf_class& y);
+
+// Write a private key file with the one key s.
+void write_private_key_binary(ostream& out, const mpz_class& s);
+
+bool read_private_key_binary(istream& in, mpz_class& s);
 
 /*----------------------------- Extended Euclidean Algorithm and Modular Inverse for Bergamo's Attack ------------------------------*/
 
@@ -91,5 +484,4 @@ mpz_class extended_euclidean(mpz_class a, mpz_class b, mpz_class* x, mpz_class*
 // This function works if and only if gcd(a, b) = 1
 mpz_class mod_inverse(mpz_class a, mpz_class b);
 
-
-
+#endif
@@ -0,0 +1,186 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This Program is the Adaptive Precision Part of the Library of our Chebyshev Article.
+#include <iostream>
+#include <string>
+#include <cmath>
+#include <algorithm>
+
+#include <gmpxx.h>
+#include "chebyshev.hpp"
+#include "chebyshev_adaptive.hpp"
+
+using namespace std;
+
+
+/*------------------------------- Doubling with a Running Error Bound -------------------------------*/
+
+
+// The same iteration as chebyshev_doubling_mpf, with the bounds e_k, e_k1 of Tk and Tk+1 next to the terms.
+void chebyshev_doubling_bound_mpf(mpf_t result, mpf_t bound, const mpf_t x, const mpf_t x_bound, const mpz_t n,
+		mp_bitcnt_t prec, chebyshev_workspace& w) {
+	mpz_t abs_n;
+	mpz_roinit_n(abs_n, mpz_limbs_read(n), mpz_size(n));
+
+	mpf_t& t_k = w.t[0];	//Tk(x)
+	mpf_t& t_k1 = w.t[1];	//Tk+1(x)
+	mpf_t& t_odd = w.t[2];	//T2k+1(x)
+	mpf_set_ui(t_k, 1);	//T0(x)
+	mpf_set(t_k1, x);	//T1(x)
+
+	// ulp = 2^(1-p), the relative error of one operation, where p >= prec is the precision mpf really keeps (whole limbs).
+	// a, a1 = |Tk|, |Tk+1|, abs_x = |x|.
+	mpf_class ulp(1, ADAPTIVE_BOUND_PREC), a(0, ADAPTIVE_BOUND_PREC), a1(0, ADAPTIVE_BOUND_PREC), abs_x(0, ADAPTIVE_BOUND_PREC);
+	mpf_class e_k(0, ADAPTIVE_BOUND_PREC), e_k1(0, ADAPTIVE_BOUND_PREC), e_odd(0, ADAPTIVE_BOUND_PREC), e_x(0, ADAPTIVE_BOUND_PREC);
+	mpf_div_2exp(ulp.get_mpf_t(), ulp.get_mpf_t(), max(prec, mpf_get_prec(t_k)) - 1);
+	mpf_abs(abs_x.get_mpf_t(), x);
+	mpf_set(e_x.get_mpf_t(), x_bound);
+	// T1 is x rounded to prec bits.
+	e_k1 = e_x + abs_x * ulp;
+
+	for (mp_bitcnt_t i = mpz_sizeinbase(abs_n, 2); i-- > 0; ) {
+		mpf_abs(a.get_mpf_t(), t_k);
+		mpf_abs(a1.get_mpf_t(), t_k1);
+
+		// T2k+1(x) = 2Tk(x)Tk+1(x) - x, which is needed for both bits.
+		mpf_mul(t_odd, t_k, t_k1);
+		mpf_mul_2exp(t_odd, t_odd, 1);
+		mpf_sub(t_odd, t_odd, x);
+		e_odd = 2*(a*e_k1 + a1*e_k + e_k*e_k1) + e_x + (4*a*a1 + abs_x) * ulp;
+
+		if (mpz_tstbit(abs_n, i)) {
+			// (Tk, Tk+1) -> (T2k+1, T2k+2)
+			mpf_mul(t_k1, t_k1, t_k1);
+			mpf_mul_2exp(t_k1, t_k1, 1);
+			mpf_sub_ui(t_k1, t_k1, 1);
+			e_k1 = 2*e_k1*(2*a1 + e_k1) + (4*a1*a1 + 1) * ulp;
+			mpf_swap(t_k, t_odd);
+			mpf_swap(e_k.get_mpf_t(), e_odd.get_mpf_t());
+		}
+		else {
+			// (Tk, Tk+1) -> (T2k, T2k+1)
+			mpf_mul(t_k, t_k, t_k);
+			mpf_mul_2exp(t_k, t_k, 1);
+			mpf_sub_ui(t_k, t_k, 1);
+			e_k = 2*e_k*(2*a + e_k) + (4*a*a + 1) * ulp;
+			mpf_swap(t_k1, t_odd);
+			mpf_swap(e_k1.get_mpf_t(), e_odd.get_mpf_t());
+		}
+		// Every digit is lost, and the e^2 terms would square the bound at every bit until its exponent overflows.
+		if (e_k > 1)
+			e_k = 1;
+		if (e_k1 > 1)
+			e_k1 = 1;
+	}
+	mpf_set(result, t_k);
+	mpf_set(bound, e_k.get_mpf_t());
+}
+
+// Tn(x) at the precision of ctx, and its error bound in bound, where x is known within x_bound.
+mpf_class chebyshev_doubling_bound(chebyshev_context& ctx, const mpf_class& x, const mpf_class& x_bound, const mpz_class& n,
+		mpf_class& bound) {
+	mpf_class result = context_mpf(ctx);
+	bound.set_prec(ADAPTIVE_BOUND_PREC);
+	chebyshev_doubling_bound_mpf(result.get_mpf_t(), bound.get_mpf_t(), x.get_mpf_t(), x_bound.get_mpf_t(), n.get_mpz_t(),
+			ctx.prec, ctx.w);
+	return result;
+}
+
+
+/*------------------------------- Adaptive Precision of Computation -------------------------------*/
+
+
+// |a| of a bound as a number of the bound precision.
+mpf_class bound_abs(const mpf_class& a) {
+	mpf_class result(0, ADAPTIVE_BOUND_PREC);
+	mpf_abs(result.get_mpf_t(), a.get_mpf_t());
+	return result;
+}
+
+bool relation_error_bound(chebyshev_context& ctx, const mpf_class& x, const mpf_class& u, const mpz_class& s,
+		const mpz_class& r, mpf_class& bound) {
+	mpf_class ulp(1, ADAPTIVE_BOUND_PREC), zero(0, ADAPTIVE_BOUND_PREC);
+	mpf_div_2exp(ulp.get_mpf_t(), ulp.get_mpf_t(), mpf_get_prec(context_mpf(ctx).get_mpf_t()) - 1);
+	mpf_class e_y, e_z0, e_z1, e_d;
+
+	// keygen and encryption: y = Ts(x), z0 = Tr(x), z1 = Tr(y) with the error of y, z2 = u*z1.
+	mpf_class y = chebyshev_doubling_bound(ctx, x, zero, s, e_y);
+	mpf_class z0 = chebyshev_doubling_bound(ctx, x, zero, r, e_z0);
+	mpf_class z1 = chebyshev_doubling_bound(ctx, y, e_y, r, e_z1);
+	mpf_class z2 = context_mpf(ctx);
+	z2 = u * z1;
+	mpf_class e_z2(0, ADAPTIVE_BOUND_PREC);
+	e_z2 = bound_abs(u) * e_z1 + bound_abs(z2) * ulp;
+
+	// decryption: Ts(z0) with the error of z0, which is Tsr(x) as z1 is.
+	mpf_class d = chebyshev_doubling_bound(ctx, z0, e_z0, s, e_d);
+	bound.set_prec(ADAPTIVE_BOUND_PREC);
+	if (d == 0 || e_y >= 1 || e_z0 >= 1 || e_z1 >= 1 || e_d >= 1) {
+		bound = 1;
+		return false;
+	}
+	mpf_class u_recover = context_mpf(ctx);
+	u_recover = z2 / d;
+
+	// |z2/d - u| = |z2 - u*d| / |d| <= (|z2 - u*Tsr(x)| + |u|*|Tsr(x) - d|) / |d|, then the rounding of the division.
+	bound = (e_z2 + bound_abs(u) * e_d) / bound_abs(d) + bound_abs(u_recover) * ulp;
+	return true;
+}
+
+// log2(a / b) for two positive bounds.
+double log2_ratio(const mpf_class& a, const mpf_class& b) {
+	long exp_a, exp_b;
+	double d_a = mpf_get_d_2exp(&exp_a, a.get_mpf_t());
+	double d_b = mpf_get_d_2exp(&exp_b, b.get_mpf_t());
+	return log2(d_a / d_b) + double(exp_a - exp_b);
+}
+
+adaptive_precision choose_precision(int n_digits_l, const mpf_class& x, const mpf_class& u, const mpz_class& s,
+		const mpz_class& r) {
+	adaptive_precision chosen;
+	chosen.evaluations = 0;
+	chosen.target = mpf_class(10, ADAPTIVE_BOUND_PREC);
+	mpf_pow_ui(chosen.target.get_mpf_t(), chosen.target.get_mpf_t(), n_digits_l);
+	chosen.target = 1 / chosen.target;
+
+	// Whether m digits are enough, with the bound in bound (1 if no digit is left).
+	auto enough = [&](int m, mpf_class& bound) {
+		chebyshev_context ctx(digits2bit_mpf(m));
+		chosen.evaluations++;
+		return relation_error_bound(ctx, x, u, s, r, bound) && bound < chosen.target;
+	};
+	// One digit of m is 3.2 bits of digits2bit_mpf, and the bound is nearly proportional to 2^-bits.
+	auto digits_for = [&](const mpf_class& bound) {
+		if (bound == 0)
+			return 0;
+		return int(ceil(log2_ratio(bound, chosen.target) / 3.2));
+	};
+
+	// Up: from m = l, jump by the predicted number of digits until the bound is below 10^-l.
+	// A bound of 1 or more has lost every digit, its e^2 terms grow without the 2^-bits law, so m is doubled instead.
+	int m = max(n_digits_l, 1);
+	mpf_class bound;
+	while (!enough(m, bound)) {
+		m += (bound >= 1) ? m : min(max(digits_for(bound), 1), m);
+	}
+
+	// Down: the slack below 10^-l predicts the smallest m, then step up to the first one that is enough.
+	mpf_class candidate_bound;
+	for (int candidate = max(m + digits_for(bound), 1); candidate < m; candidate++) {
+		if (enough(candidate, candidate_bound)) {
+			m = candidate;
+			bound = candidate_bound;
+			break;
+		}
+	}
+	// Confirm that m - 1 is not enough.
+	while (m > 1 && enough(m - 1, candidate_bound)) {
+		m--;
+		bound = candidate_bound;
+	}
+
+	chosen.n_digits_m = m;
+	chosen.bound = bound;
+	return chosen;
+}
@@ -0,0 +1,75 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This Program is the Adaptive Precision Part of the Library of our Chebyshev Article.
+// Instead of a precision m of computation picked by hand from the tables of chebyshev_gmp_relation, the doubling
+// iteration carries a bound of its forward error next to every term, and the smallest m is chosen such that the
+// bound of |u - u_recover| over keygen, encryption and decryption is below 10^-l.
+//
+// Error bound, with u = 2^(1-p) the relative error of one mpf_mul or mpf_sub, where p = mpf_get_prec >= prec is the
+// precision mpf really keeps in its whole limbs (mpf truncates),
+// and e, e1 the bounds of |Tk~ - Tk| and |Tk+1~ - Tk+1| where a = |Tk~| and a1 = |Tk+1~| are the computed values:
+// - T2k = 2Tk^2 - 1 gets at most 2e(2a + e) from the error of Tk, and (4a^2 + 1)u from its product and subtraction.
+// - T2k+1 = 2TkTk+1 - x gets at most 2(a*e1 + a1*e + e*e1) from the errors of Tk and Tk+1, the error of x,
+//   and (4a*a1 + |x|)u from its product and subtraction.
+// A bound above 1 means that every digit is lost, and it stays at 1 from there.
+// The bound uses the computed terms, not |Tk| <= 1, so it follows the real growth of the error instead of 4^bits.
+// The bounds themselves are mpf of ADAPTIVE_BOUND_PREC bits, whose exponent does not overflow as a double would
+// for large n, and are exact up to a relative 2^-60 or so, far below the margin between two precisions.
+#ifndef CHEBYSHEV_ADAPTIVE_HPP
+#define CHEBYSHEV_ADAPTIVE_HPP
+
+#include <iostream>
+#include <string>
+
+#include <gmpxx.h>
+#include "chebyshev.hpp"
+
+using namespace std;
+
+
+/*------------------------------- Doubling with a Running Error Bound -------------------------------*/
+
+
+// The precision of the error bounds, in bits.
+#define ADAPTIVE_BOUND_PREC 64
+
+// result = Tn(x) by the doubling iteration at the precision of w, and bound >= |result - Tn(x*)| for every x* with
+// |x - x*| <= x_bound. prec is the precision of w, bound and x_bound are at ADAPTIVE_BOUND_PREC bits.
+void chebyshev_doubling_bound_mpf(mpf_t result, mpf_t bound, const mpf_t x, const mpf_t x_bound, const mpz_t n,
+		mp_bitcnt_t prec, chebyshev_workspace& w);
+
+// Tn(x) at the precision of ctx, and its error bound in bound, where x is known within x_bound.
+mpf_class chebyshev_doubling_bound(chebyshev_context& ctx, const mpf_class& x, const mpf_class& x_bound, const mpz_class& n,
+		mpf_class& bound);
+
+
+/*------------------------------- Adaptive Precision of Computation -------------------------------*/
+
+
+// The bound of |u - u_recover| when everything is computed at the precision of ctx: y = Ts(x), z0 = Tr(x),
+// z2 = u*Tr(y) and u_recover = z2 / Ts(z0), with x and u exact. Return false, with bound = 1, if a term has lost every
+// digit or Ts(z0) is 0 at this precision.
+bool relation_error_bound(chebyshev_context& ctx, const mpf_class& x, const mpf_class& u, const mpz_class& s,
+		const mpz_class& r, mpf_class& bound);
+
+// The precision chosen by choose_precision, the bound of |u - u_recover| at this precision, the target 10^-l,
+// and the number of precisions tried.
+struct adaptive_precision {
+	int n_digits_m;
+	mpf_class bound;
+	mpf_class target;
+	int evaluations;
+};
+
+// The digits added to the m of choose_precision when one r stands for every r between s/2 and s.
+#define ADAPTIVE_MARGIN_DIGITS 2
+
+// The smallest number of digits m such that relation_error_bound guarantees |u - u_recover| < 10^-l for s and r.
+// The bound is nearly proportional to 10^-m, so one evaluation predicts m, and the neighbours confirm it.
+// It bounds the error of this r only. For the encryption of many blocks, r between s/2 and s, r = s - 1 as in
+// chebyshev_gmp_relation is a heuristic for all of them, with ADAPTIVE_MARGIN_DIGITS more digits on top.
+adaptive_precision choose_precision(int n_digits_l, const mpf_class& x, const mpf_class& u, const mpz_class& s,
+		const mpz_class& r);
+
+#endif
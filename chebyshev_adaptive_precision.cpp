@@ -0,0 +1,78 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This program is the adaptive mode of chebyshev_gmp_relation: instead of trying a precision m given by hand, it chooses
+// for every length of the secret key s = 10^length (and r = s - 1) the smallest m whose running error bound
+// (chebyshev_adaptive.hpp) guarantees l correct digits of u, with x = 0.111... and u = 0.0101... of l digits.
+// Then it runs keygen, encryption and decryption at this m with chebyshev_doubling, and prints the chosen m,
+// the bound, the real |u - u_recover| (which must be below the bound), and whether u was recovered within 10^-l.
+
+// In order to compile and run this program, you need to install two libraries: GMP and MPFR.
+// Compile: g++ -o chebyshev_adaptive_precision chebyshev_adaptive_precision.cpp chebyshev.cpp chebyshev_adaptive.cpp -lmpfr -lgmpxx -lgmp
+// Run: ./chebyshev_adaptive_precision <precision l> <first length of secret key> <last length of secret key>
+#include <iostream>
+#include <string>
+#include <chrono>
+
+#include <gmpxx.h>
+#include <mpreal.h>
+#include "chebyshev.hpp"
+#include "chebyshev_adaptive.hpp"
+
+using namespace std;
+
+int main (int argc, char* argv[]) {
+	int n_digits_l = 0, first_length = 0, last_length = 0;
+	if (argc == 4) {
+		n_digits_l = atoi(argv[1]);
+		first_length = atoi(argv[2]);
+		last_length = atoi(argv[3]);
+	}
+	if (argc != 4 || n_digits_l < 2 || first_length <= 0 || last_length < first_length) {
+		cout << "Notice: If you want to run this program, you need 3 inputs, such that: " << endl;
+		cout << "Example: ./chebyshev_adaptive_precision <precision l> <first length of secret key> <last length of secret key> " << endl;
+		cout << "For example: ./chebyshev_adaptive_precision 100 1 64" << endl;
+		return 0;
+	}
+
+	// x = 0.1111... and u = 0.0101... with precision l number of digits, error = 10^-l.
+	mp_bitcnt_t prec_l = digits2bit_mpf(n_digits_l);
+	string x_string = "1", u_string = "01", error_string = "0";
+	while (x_string.length() < n_digits_l)
+		x_string += "1";
+	while (u_string.length() < n_digits_l)
+		u_string += "01";
+	while (error_string.length() < n_digits_l - 1)
+		error_string += "0";
+	mpf_class x(0, prec_l), u(0, prec_l), error(0, prec_l);
+	x.set_str("0." + x_string, 10);
+	u.set_str("0." + u_string, 10);
+	error.set_str("0." + error_string + "1", 10);
+
+	cout.precision(6);
+	cout << "l, length of s, m, bound, difference, success, evaluations, seconds" << endl;
+	for (int length = first_length; length <= last_length; length++) {
+		mpz_class s;
+		mpz_ui_pow_ui(s.get_mpz_t(), 10, length);
+		mpz_class r = s - 1;
+
+		auto start = chrono::steady_clock::now();
+		adaptive_precision chosen = choose_precision(n_digits_l, x, u, s, r);
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+		chebyshev_context ctx(digits2bit_mpf(chosen.n_digits_m));
+		mpf_class y = chebyshev_doubling(ctx, x, s);
+		mpf_class z0 = chebyshev_doubling(ctx, x, r);
+		mpf_class z2 = context_mpf(ctx);
+		z2 = u * chebyshev_doubling(ctx, y, r);
+		mpf_class u_recover = context_mpf(ctx);
+		u_recover = z2 / chebyshev_doubling(ctx, z0, s);
+		mpf_class difference = context_mpf(ctx);
+		difference = abs(u - u_recover);
+
+		cout << n_digits_l << ", " << length << ", " << chosen.n_digits_m << ", " << chosen.bound << ", " << difference << ", ";
+		cout << (difference < error ? "yes" : "no") << ", " << chosen.evaluations << ", " << seconds << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,129 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This program counts the heap allocations of one evaluation of Ts(x).
+// GMP allocates limbs through the functions given to mp_set_memory_functions, and C++ through operator new,
+// so we count both of them. chebyshev_ladder_mpf and chebyshev_doubling_mpf take all their temporaries from a
+// chebyshev_workspace, so once the workspace is built, the evaluations must do 0 allocation.
+// For comparison we also count the allocations of chebyshev_economical.
+// Notice that GMP itself uses the heap for the temporaries of mpf_mul above ~4000 limbs, so keep m below ~70000 digits.
+
+// In order to compile and run this program, you need to install two libraries: GMP and MPFR.
+// Compile: g++ -o chebyshev_allocation_test chebyshev_allocation_test.cpp chebyshev.cpp -lmpfr -lgmpxx -lgmp
+// Run: ./chebyshev_allocation_test <precision m> <length of secret key> (s = 10^length)
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <new>
+
+#include <gmpxx.h>
+#include <mpreal.h>
+#include "chebyshev.hpp"
+
+using namespace std;
+
+
+/*---------------------------------- Allocation Counter -----------------------------------*/
+
+
+static unsigned long n_allocations = 0;
+
+void* count_allocate(size_t size) {
+	n_allocations++;
+	return malloc(size);
+}
+
+void* count_reallocate(void* ptr, size_t /*old_size*/, size_t new_size) {
+	n_allocations++;
+	return realloc(ptr, new_size);
+}
+
+void count_free(void* ptr, size_t /*size*/) {
+	free(ptr);
+}
+
+void* operator new(size_t size) {
+	n_allocations++;
+	void* ptr = malloc(size);
+	if (ptr == NULL) {
+		throw bad_alloc();
+	}
+	return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+	free(ptr);
+}
+
+void operator delete(void* ptr, size_t /*size*/) noexcept {
+	free(ptr);
+}
+
+
+/*----------------------------------- Main: Experiment here -----------------------------------*/
+
+
+int main (int argc, char* argv[]) {
+	int n_digits_m, n_s;
+	if (argc == 3) {
+		n_digits_m = atoi(argv[1]);
+		n_s = atoi(argv[2]);
+	}
+	else {
+		cout << "Notice: If you want to run this program, you need 2 inputs, such that: " << endl;
+		cout << "Example: ./chebyshev_allocation_test <precision m> <length of secret key> (s = 10^length) " << endl;
+		cout << "For example: ./chebyshev_allocation_test 120 8" << endl;
+		return 0;
+	}
+	mp_set_memory_functions(count_allocate, count_reallocate, count_free);
+
+	mpf_set_default_prec(digits2bit_mpf(n_digits_m));
+	cout << "Precision m of mpf for computation is: " << mpf_get_default_prec() << ", where 3.2 bit represents one decimal digit in average. ";
+	cout << "Which is " << int(mpf_get_default_prec() / 3.2) << " digits." << endl;
+
+	// Choose x as 0.111... with precision m number of digits.
+	mpf_class x;
+	string tmp_string = "1";
+	string x_string = "1";
+	while (x_string.length() < n_digits_m)
+		x_string += tmp_string;
+	x.set_str((const char*)(("0." + x_string).c_str()), 10);
+
+	mpz_class s;
+	mpz_ui_pow_ui(s.get_mpz_t(), 10, n_s);
+	cout << "s = 10^" << n_s << endl << endl;
+
+	/*----------------------------------- Start Experiment -----------------------------------*/
+
+	chebyshev_workspace w(mpf_get_default_prec());
+	mpf_class y;
+	int n_iterations = 100;
+
+	// The first evaluation is the warmup.
+	chebyshev_ladder_mpf(y.get_mpf_t(), x.get_mpf_t(), s.get_mpz_t(), w);
+	n_allocations = 0;
+	for (int i = 0; i < n_iterations; i++) {
+		chebyshev_ladder_mpf(y.get_mpf_t(), x.get_mpf_t(), s.get_mpz_t(), w);
+	}
+	unsigned long n_allocations_ladder = n_allocations;
+	cout << "chebyshev_ladder_mpf:   " << n_allocations_ladder << " allocations in " << n_iterations << " evaluations" << endl;
+
+	chebyshev_doubling_mpf(y.get_mpf_t(), x.get_mpf_t(), s.get_mpz_t(), w);
+	n_allocations = 0;
+	for (int i = 0; i < n_iterations; i++) {
+		chebyshev_doubling_mpf(y.get_mpf_t(), x.get_mpf_t(), s.get_mpz_t(), w);
+	}
+	unsigned long n_allocations_doubling = n_allocations;
+	cout << "chebyshev_doubling_mpf: " << n_allocations_doubling << " allocations in " << n_iterations << " evaluations" << endl;
+
+	n_allocations = 0;
+	y = chebyshev_economical(x, s);
+	cout << "chebyshev_economical:   " << n_allocations << " allocations in 1 evaluation" << endl << endl;
+
+	if (n_allocations_ladder != 0 || n_allocations_doubling != 0) {
+		cout << "The evaluation with a workspace allocated memory!!" << endl;
+		return 1;
+	}
+	cout << "The evaluation with a workspace does no heap allocation." << endl;
+	return 0;
+}
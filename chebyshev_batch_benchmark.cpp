@@ -0,0 +1,104 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This program measures the throughput of chebyshev_batch, which evaluates Ts(x) for many x with the same s,
+// against one call of chebyshev_doubling per x, for batches of 1, 16, 256 and 4096 inputs.
+// This is the situation of the decryption, where the same private key s is used for every z0.
+
+// In order to compile and run this program, you need to install two libraries: GMP and MPFR.
+// Compile: g++ -o chebyshev_batch_benchmark chebyshev_batch_benchmark.cpp chebyshev.cpp -lmpfr -lgmpxx -lgmp
+// Run: ./chebyshev_batch_benchmark <precision m> <length of secret key> (s = 10^length)
+#include <iostream>
+#include <string>
+
+#include <gmpxx.h>
+#include <mpreal.h>
+#include "chebyshev.hpp"
+
+#include <time.h>
+
+using namespace std;
+
+int main (int argc, char* argv[]) {
+	int n_digits_m, n_s;
+	if (argc == 3) {
+		n_digits_m = atoi(argv[1]);
+		n_s = atoi(argv[2]);
+	}
+	else {
+		cout << "Notice: If you want to run this program, you need 2 inputs, such that: " << endl;
+		cout << "Example: ./chebyshev_batch_benchmark <precision m> <length of secret key> (s = 10^length) " << endl;
+		cout << "For example: ./chebyshev_batch_benchmark 120 8" << endl;
+		return 0;
+	}
+
+	/*----------------------------------- Preparation/Assignment -----------------------------------*/
+
+	chebyshev_context ctx(digits2bit_mpf(n_digits_m));
+	cout << "Precision m of mpf for computation is: " << ctx.prec << ", where 3.2 bit represents one decimal digit in average. ";
+	cout << "Which is " << int(ctx.prec / 3.2) << " digits." << endl;
+
+	mpz_class s;
+	mpz_ui_pow_ui(s.get_mpz_t(), 10, n_s);
+	cout << "s = 10^" << n_s << endl << endl;
+
+	// Choose x_i = 0.111.../(i+1) with precision m number of digits.
+	string tmp_string = "1";
+	string x_string = "1";
+	while (x_string.length() < n_digits_m)
+		x_string += tmp_string;
+	mpf_class x = context_mpf(ctx, "0." + x_string);
+
+	int max_batch_n = 4096;
+	mpf_class* x_list = new mpf_class[max_batch_n];
+	mpf_class* y_list = new mpf_class[max_batch_n];
+	mpf_class y = context_mpf(ctx);
+	for (int i = 0; i < max_batch_n; i++) {
+		x_list[i].set_prec(ctx.prec);
+		x_list[i] = x / (i + 1);
+	}
+
+	/*----------------------------------- Start Experiment -----------------------------------*/
+
+	int n_batches = 4;
+	int batch_n[] = {1, 16, 256, 4096};
+
+	clock_t start, end;
+	cout.precision(6);
+	for (int i = 0; i < n_batches; i++) {
+		// Repeat the small batches such that every batch size does about the same work.
+		int repetitions = max_batch_n / batch_n[i];
+
+		start = clock();
+		for (int k = 0; k < repetitions; k++) {
+			for (int j = 0; j < batch_n[i]; j++) {
+				y = chebyshev_doubling(ctx, x_list[j], s);
+			}
+		}
+		end = clock();
+		double time_single = double(end - start)/CLOCKS_PER_SEC;
+
+		start = clock();
+		for (int k = 0; k < repetitions; k++) {
+			chebyshev_batch(ctx, x_list, batch_n[i], s, y_list);
+		}
+		end = clock();
+		double time_batch = double(end - start)/CLOCKS_PER_SEC;
+
+		// Compare the batch with the single evaluation.
+		mpf_class difference = 0;
+		for (int j = 0; j < batch_n[i]; j++) {
+			difference = max(difference, mpf_class(abs(y_list[j] - chebyshev_doubling(ctx, x_list[j], s))));
+		}
+
+		double n_evaluations = double(repetitions) * batch_n[i];
+		cout << "Batch of " << batch_n[i] << ":" << endl;
+		cout << "One by one: " << n_evaluations / time_single << " evaluations/s" << endl;
+		cout << "Batch:      " << n_evaluations / time_batch << " evaluations/s" << endl;
+		cout << "Largest difference = " << difference.get_d() << endl << endl;
+	}
+
+	delete[] x_list;
+	delete[] y_list;
+	return 0;
+}
@@ -0,0 +1,200 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This Program is the Calibration Part of the Library of our Chebyshev Article.
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include <gmpxx.h>
+#include "chebyshev.hpp"
+#include "chebyshev_calibration.hpp"
+
+using namespace std;
+
+
+/*------------------------------- Calibration Table -------------------------------*/
+
+
+calibration_table::calibration_table() : l_first(0), l_last(0), key_length_last(0) {
+}
+
+bool calibration_less(const calibration_record& a, const calibration_record& b) {
+	return a.n_digits_l < b.n_digits_l || (a.n_digits_l == b.n_digits_l && a.n_digits_m < b.n_digits_m);
+}
+
+void calibration_add(calibration_table& table, int n_digits_l, int n_digits_m, int key_length, bool success) {
+	calibration_record record = {n_digits_l, n_digits_m, 0, 0};
+	auto it = lower_bound(table.records.begin(), table.records.end(), record, calibration_less);
+	if (it == table.records.end() || it->n_digits_l != n_digits_l || it->n_digits_m != n_digits_m) {
+		it = table.records.insert(it, record);
+	}
+	bool below_failure = (it->failed_key_length == 0 || key_length < it->failed_key_length);
+	if (success && below_failure) {
+		it->max_key_length = max(it->max_key_length, key_length);
+	}
+	else if (!success && below_failure) {
+		it->failed_key_length = key_length;
+		it->max_key_length = min(it->max_key_length, key_length - 1);
+	}
+}
+
+// v0 + (v1 - v0)*(t - t0)/(t1 - t0), rounded up, for t0 < t <= t1.
+int interpolate_up(int t0, int v0, int t1, int v1, int t) {
+	return v0 + int(ceil(double(v1 - v0) * (t - t0) / (t1 - t0)));
+}
+
+bool calibration_build(calibration_table& table) {
+	table.min_m.clear();
+	table.l_first = table.l_last = table.key_length_last = 0;
+	if (table.records.empty()) {
+		return true;
+	}
+	int K = 0;
+	for (const calibration_record& record : table.records) {
+		K = max(K, record.max_key_length);
+	}
+	int l_first = table.records.front().n_digits_l;
+	int l_last = table.records.back().n_digits_l;
+	if (double(l_last - l_first + 1) * K > CALIBRATION_MAX_ENTRIES) {
+		return false;
+	}
+	table.l_first = l_first;
+	table.l_last = l_last;
+	table.key_length_last = K;
+	table.min_m.assign(size_t(table.l_last - table.l_first + 1) * K, 0);
+
+	// The rows of the measured l: the records of one l are sorted by m, the first one that decrypts a key length is
+	// an m that is enough, and the one before it an m that is not, so the smallest m is between these two.
+	vector<int> measured;
+	for (size_t a = 0; a < table.records.size(); ) {
+		int l = table.records[a].n_digits_l;
+		size_t b = a;
+		while (b < table.records.size() && table.records[b].n_digits_l == l)
+			b++;
+		const calibration_record* points = &table.records[a];
+		size_t points_n = b - a;
+		int* row = &table.min_m[size_t(l - table.l_first) * K];
+		size_t i = 0;
+		for (int key_length = 1; key_length <= K; key_length++) {
+			while (i < points_n && points[i].max_key_length < key_length)
+				i++;
+			if (i == points_n)
+				break;
+			if (i == 0) {
+				row[key_length - 1] = points[0].n_digits_m;
+			}
+			else {
+				row[key_length - 1] = interpolate_up(points[i - 1].max_key_length, points[i - 1].n_digits_m,
+						points[i].max_key_length, points[i].n_digits_m, key_length);
+			}
+		}
+		measured.push_back(l);
+		a = b;
+	}
+
+	// The rows of the l between two measured ones.
+	for (size_t j = 0; j + 1 < measured.size(); j++) {
+		int l0 = measured[j], l1 = measured[j + 1];
+		const int* row0 = &table.min_m[size_t(l0 - table.l_first) * K];
+		const int* row1 = &table.min_m[size_t(l1 - table.l_first) * K];
+		for (int l = l0 + 1; l < l1; l++) {
+			int* row = &table.min_m[size_t(l - table.l_first) * K];
+			for (int k = 0; k < K; k++) {
+				if (row0[k] > 0 && row1[k] > 0)
+					row[k] = interpolate_up(l0, row0[k], l1, row1[k], l);
+			}
+		}
+	}
+	return true;
+}
+
+int calibration_min_precision(const calibration_table& table, int n_digits_l, int key_length) {
+	if (table.min_m.empty() || n_digits_l < table.l_first || n_digits_l > table.l_last
+			|| key_length < 1 || key_length > table.key_length_last) {
+		return 0;
+	}
+	return table.min_m[size_t(n_digits_l - table.l_first) * table.key_length_last + key_length - 1];
+}
+
+
+/*------------------------------- Calibration File -------------------------------*/
+
+
+void write_calibration_binary(ostream& out, const calibration_table& table) {
+	int m_last = 1;
+	for (const calibration_record& record : table.records) {
+		m_last = max(m_last, record.n_digits_m);
+	}
+	chebyshev_file_header header = {CHEBYSHEV_FORMAT_VERSION, FILE_CALIBRATION, 0, digits2bit_mpf(m_last),
+			table.records.size(), 0, 0};
+	write_header_binary(out, header);
+	for (const calibration_record& record : table.records) {
+		write_uint_binary(out, record.n_digits_l, 4);
+		write_uint_binary(out, record.n_digits_m, 4);
+		write_uint_binary(out, record.max_key_length, 4);
+		write_uint_binary(out, record.failed_key_length, 4);
+	}
+}
+
+bool read_calibration_binary(istream& in, calibration_table& table) {
+	chebyshev_file_header header;
+	if (!read_header_binary(in, header) || header.kind != FILE_CALIBRATION) {
+		return false;
+	}
+	calibration_table read;
+	for (unsigned long long i = 0; i < header.blocks_n; i++) {
+		unsigned long long l, m, key_length, failed_key_length;
+		if (!read_uint_binary(in, l, 4) || !read_uint_binary(in, m, 4) || !read_uint_binary(in, key_length, 4)
+				|| !read_uint_binary(in, failed_key_length, 4) || l == 0 || m == 0 || l > CALIBRATION_MAX_DIGITS
+				|| m > CALIBRATION_MAX_DIGITS || key_length > CALIBRATION_MAX_KEY_LENGTH
+				|| failed_key_length > CALIBRATION_MAX_KEY_LENGTH
+				|| (failed_key_length > 0 && key_length >= failed_key_length) || (key_length == 0 && failed_key_length == 0)) {
+			return false;
+		}
+		// The failure first, such that the success is not capped again.
+		if (failed_key_length > 0) {
+			calibration_add(read, int(l), int(m), int(failed_key_length), false);
+		}
+		if (key_length > 0) {
+			calibration_add(read, int(l), int(m), int(key_length), true);
+		}
+	}
+	if (!calibration_build(read)) {
+		return false;
+	}
+	table = read;
+	return true;
+}
+
+bool load_calibration(const string& path, calibration_table& table) {
+	ifstream in(path, ios::binary);
+	if (!in) {
+		table = calibration_table();
+		return true;
+	}
+	return read_calibration_binary(in, table);
+}
+
+bool save_calibration(const string& path, const calibration_table& table) {
+	ofstream out(path, ios::binary);
+	if (!out) {
+		return false;
+	}
+	write_calibration_binary(out, table);
+	return bool(out);
+}
+
+const calibration_table& calibration_default() {
+	static const calibration_table table = []() {
+		calibration_table loaded;
+		const char* path = getenv("CHEBYSHEV_CALIBRATION");
+		load_calibration(path ? path : CALIBRATION_DEFAULT_PATH, loaded);
+		return loaded;
+	}();
+	return table;
+}
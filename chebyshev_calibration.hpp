@@ -0,0 +1,93 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This Program is the Calibration Part of the Library of our Chebyshev Article: the results of chebyshev_gmp_relation,
+// chebyshev_gmp_relation_average and chebyshev_relation_sweep, kept on disk as records (l, m, largest key length that
+// decrypts, shortest key length that fails), and a dense table of the smallest m for every l and key length, such that
+// a program that encrypts only reads the table instead of running a probe or picking m by hand.
+// When m is far too small, a long s can decrypt by chance after a shorter one has failed, so the largest key length
+// that decrypts is always kept below the shortest one that fails.
+//
+// The file has the header of the binary format of chebyshev.hpp with kind FILE_CALIBRATION, prec the bits of the largest
+// m and blocks_n the number of records, then per record l, m, the largest key length and the shortest failing key length
+// (4 bytes each, little-endian). l and m are at most CALIBRATION_MAX_DIGITS, the key lengths at most
+// CALIBRATION_MAX_KEY_LENGTH, and the dense table at most CALIBRATION_MAX_ENTRIES, or the file is malformed.
+// The largest key length is nearly linear in m for a given l, so the smallest m of a key length between two measured
+// ones is interpolated between them (rounded up), and an l between two measured ones between their m.
+// A key length longer than every measured one, or an l out of the measured ones, is unknown: we do not extrapolate.
+#ifndef CHEBYSHEV_CALIBRATION_HPP
+#define CHEBYSHEV_CALIBRATION_HPP
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gmpxx.h>
+#include "chebyshev.hpp"
+
+using namespace std;
+
+
+/*------------------------------- Calibration Table -------------------------------*/
+
+
+// The file read by calibration_default, unless the environment variable CHEBYSHEV_CALIBRATION gives another one.
+#define CALIBRATION_DEFAULT_PATH "chebyshev_calibration.bin"
+
+// The largest l and m, the largest key length, and the largest number of entries of the dense table (64 MB).
+#define CALIBRATION_MAX_DIGITS 1000000
+#define CALIBRATION_MAX_KEY_LENGTH 100000
+#define CALIBRATION_MAX_ENTRIES (1 << 24)
+
+// For the precisions l and m, the key lengths up to max_key_length (s = 10^length) decrypt, 0 if none was seen,
+// and failed_key_length is the shortest one that fails, 0 if none was seen. max_key_length < failed_key_length.
+struct calibration_record {
+	int n_digits_l;
+	int n_digits_m;
+	int max_key_length;
+	int failed_key_length;
+};
+
+// The records, sorted by (l, m), and once calibration_build is called, the smallest m of every l from l_first
+// to l_last and every key length from 1 to key_length_last in min_m[(l - l_first)*key_length_last + key_length - 1],
+// 0 where it is unknown.
+struct calibration_table {
+	vector<calibration_record> records;
+	int l_first;
+	int l_last;
+	int key_length_last;
+	vector<int> min_m;
+
+	calibration_table();
+};
+
+// Add the result of one probe of (l, m). A success counts only below the shortest failure. A failure below the largest
+// success caps it just under the failure, as the lengths between them are not known (add the probes of one run from
+// the shortest key length up, and the cap is exact).
+void calibration_add(calibration_table& table, int n_digits_l, int n_digits_m, int key_length, bool success);
+
+// Fill the dense table from the records. Return false, with an empty table, if it would have more than
+// CALIBRATION_MAX_ENTRIES entries.
+bool calibration_build(calibration_table& table);
+
+// The smallest m for l correct digits with a key s = 10^key_length, or 0 if it is unknown. One index, no search.
+int calibration_min_precision(const calibration_table& table, int n_digits_l, int key_length);
+
+
+/*------------------------------- Calibration File -------------------------------*/
+
+
+void write_calibration_binary(ostream& out, const calibration_table& table);
+
+// Read the records of a calibration file into table, and build it. Return false if it is malformed.
+bool read_calibration_binary(istream& in, calibration_table& table);
+
+// Read path into table. A missing file is an empty table, and returns true; a malformed one returns false.
+bool load_calibration(const string& path, calibration_table& table);
+
+bool save_calibration(const string& path, const calibration_table& table);
+
+// The table of CHEBYSHEV_CALIBRATION or CALIBRATION_DEFAULT_PATH, read once at the first call.
+const calibration_table& calibration_default();
+
+#endif
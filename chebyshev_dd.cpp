@@ -0,0 +1,157 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This Program is the Double-Double & Quad-Double Part of the Library of our Chebyshev Article:
+// Tn(x) on double-double and quad-double numbers, one at a time or DD_LANES at a time. See chebyshev_dd.hpp.
+#include <iostream>
+#include <string>
+#include <cmath>
+
+#include <gmpxx.h>
+#include "chebyshev.hpp"
+#include "chebyshev_dd.hpp"
+
+using namespace std;
+
+
+/*------------------------------- Conversions -------------------------------*/
+
+
+string dd_lane_name() {
+#if defined(__AVX512F__)
+	return "AVX-512, 8 lanes";
+#elif defined(__AVX2__) && defined(__FMA__)
+	return "AVX2, 4 lanes";
+#else
+	return "scalar, 1 lane";
+#endif
+}
+
+// The parts of x, each the double of the remainder. get_d truncates toward zero, so a part is not the nearest double,
+// but every part is exact, so the remainder stays exact and the sum of the parts is x up to the last part.
+void mpf_to_parts(const mpf_class& x, double* parts, int n_parts) {
+	mpf_class remainder(x, mpf_get_prec(x.get_mpf_t()));
+	for (int i = 0; i < n_parts; i++) {
+		parts[i] = remainder.get_d();
+		remainder -= parts[i];
+	}
+}
+
+mpf_class parts_to_mpf(const double* parts, int n_parts) {
+	mpf_class result(0, 1100);
+	for (int i = 0; i < n_parts; i++) {
+		result += parts[i];
+	}
+	return result;
+}
+
+dd_real mpf_to_dd(const mpf_class& x) {
+	double parts[2];
+	mpf_to_parts(x, parts, 2);
+	dd_real a = {parts[0], parts[1]};
+	return a;
+}
+
+qd_real mpf_to_qd(const mpf_class& x) {
+	qd_real a;
+	mpf_to_parts(x, a.c, 4);
+	return a;
+}
+
+mpf_class dd_to_mpf(const dd_real& a) {
+	double parts[2] = {a.hi, a.lo};
+	return parts_to_mpf(parts, 2);
+}
+
+mpf_class qd_to_mpf(const qd_real& a) {
+	return parts_to_mpf(a.c, 4);
+}
+
+
+/*------------------------------- Chebyshev Doubling on Double-Double & Quad-Double -------------------------------*/
+
+
+dd_real chebyshev_doubling_dd(const dd_real& x, const mpz_class& n) {
+	dd_lanes<double> x_lanes = {x.hi, x.lo};
+	dd_lanes<double> t = chebyshev_doubling_lanes(x_lanes, n);
+	dd_real result = {t.hi, t.lo};
+	return result;
+}
+
+qd_real chebyshev_doubling_qd(const qd_real& x, const mpz_class& n) {
+	qd_lanes<double> x_lanes = {{x.c[0], x.c[1], x.c[2], x.c[3]}};
+	qd_lanes<double> t = chebyshev_doubling_lanes(x_lanes, n);
+	qd_real result = {{t.c[0], t.c[1], t.c[2], t.c[3]}};
+	return result;
+}
+
+// The vector types carry alignment attributes, which GCC drops in the template arguments dd_lanes<dd_lane> without harm.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wignored-attributes"
+
+void chebyshev_doubling_dd_batch(const dd_real* x_list, int count, const mpz_class& n, dd_real* result_list) {
+	int i = 0;
+	// The lanes take the parts from the list of dd_real, and give them back.
+	double buffer[2][DD_LANES];
+	for (; i + DD_LANES <= count; i += DD_LANES) {
+		for (int j = 0; j < DD_LANES; j++) {
+			buffer[0][j] = x_list[i + j].hi;
+			buffer[1][j] = x_list[i + j].lo;
+		}
+		dd_lanes<dd_lane> x = {lane_load<dd_lane>(buffer[0]), lane_load<dd_lane>(buffer[1])};
+		dd_lanes<dd_lane> t = chebyshev_doubling_lanes(x, n);
+		lane_store(buffer[0], t.hi);
+		lane_store(buffer[1], t.lo);
+		for (int j = 0; j < DD_LANES; j++) {
+			result_list[i + j].hi = buffer[0][j];
+			result_list[i + j].lo = buffer[1][j];
+		}
+	}
+	for (; i < count; i++) {
+		result_list[i] = chebyshev_doubling_dd(x_list[i], n);
+	}
+}
+
+void chebyshev_doubling_qd_batch(const qd_real* x_list, int count, const mpz_class& n, qd_real* result_list) {
+	int i = 0;
+	double buffer[4][DD_LANES];
+	for (; i + DD_LANES <= count; i += DD_LANES) {
+		qd_lanes<dd_lane> x;
+		for (int k = 0; k < 4; k++) {
+			for (int j = 0; j < DD_LANES; j++) {
+				buffer[k][j] = x_list[i + j].c[k];
+			}
+			x.c[k] = lane_load<dd_lane>(buffer[k]);
+		}
+		qd_lanes<dd_lane> t = chebyshev_doubling_lanes(x, n);
+		for (int k = 0; k < 4; k++) {
+			lane_store(buffer[k], t.c[k]);
+			for (int j = 0; j < DD_LANES; j++) {
+				result_list[i + j].c[k] = buffer[k][j];
+			}
+		}
+	}
+	for (; i < count; i++) {
+		result_list[i] = chebyshev_doubling_qd(x_list[i], n);
+	}
+}
+
+#pragma GCC diagnostic pop
+
+mpf_class chebyshev_doubling_small(chebyshev_context& ctx, const mpf_class& x, const mpz_class& n) {
+	// Out of [-1, 1] Tn(x) grows as cosh and overflows a double, and a far too small precision can do the same.
+	bool in_range = (abs(x) <= 1);
+	if (in_range && ctx.prec <= DD_MAX_PREC) {
+		dd_real t = chebyshev_doubling_dd(mpf_to_dd(x), n);
+		if (isfinite(t.hi) && isfinite(t.lo)) {
+			return mpf_class(dd_to_mpf(t), ctx.prec);
+		}
+	}
+	else if (in_range && ctx.prec <= QD_MAX_PREC) {
+		qd_real t = chebyshev_doubling_qd(mpf_to_qd(x), n);
+		if (isfinite(t.c[0]) && isfinite(t.c[1]) && isfinite(t.c[2]) && isfinite(t.c[3])) {
+			return mpf_class(qd_to_mpf(t), ctx.prec);
+		}
+	}
+	return chebyshev_doubling(ctx, x, n);
+}
@@ -0,0 +1,376 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This Program is the Double-Double & Quad-Double Part of the Library of our Chebyshev Article.
+// A double-double is an unevaluated sum hi + lo of 2 doubles (106 bits, about 32 digits), and a quad-double is a sum of
+// 4 doubles (212 bits, about 64 digits). They are exact sums and products of doubles (error-free transformations),
+// so for the parameter studies at 30 to 60 digits they replace mpf with a few floating point instructions.
+// The kernels are templates on the lane type V: double for the scalar code, __m256d with AVX2 & FMA (4 lanes),
+// and __m512d with AVX-512 (8 lanes), so one instruction evaluates Tn(x) for 4 or 8 different x.
+// The lane type is chosen when compiling (-march=native), and without AVX2 every lane type is double.
+#ifndef CHEBYSHEV_DD_HPP
+#define CHEBYSHEV_DD_HPP
+
+#include <iostream>
+#include <string>
+#include <cmath>
+
+#include <gmpxx.h>
+#include "chebyshev.hpp"
+
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+
+// The largest precisions, in bits, that double-double (106 bits) and quad-double (212 bits) hold.
+#define DD_MAX_PREC 104
+#define QD_MAX_PREC 208
+
+
+/*------------------------------- Lanes -------------------------------*/
+
+
+#if defined(__AVX512F__)
+typedef __m512d dd_lane;
+#define DD_LANES 8
+#elif defined(__AVX2__) && defined(__FMA__)
+typedef __m256d dd_lane;
+#define DD_LANES 4
+#else
+typedef double dd_lane;
+#define DD_LANES 1
+#endif
+
+// The name of the lane type, for the programs.
+string dd_lane_name();
+
+template <class V> inline V lane_broadcast(double a);
+template <class V> inline V lane_load(const double* p);
+template <class V> inline void lane_store(double* p, V a);
+
+template <> inline double lane_broadcast<double>(double a) {
+	return a;
+}
+template <> inline double lane_load<double>(const double* p) {
+	return *p;
+}
+template <> inline void lane_store<double>(double* p, double a) {
+	*p = a;
+}
+// a*b - c with one rounding.
+inline double lane_fms(double a, double b, double c) {
+	return fma(a, b, -c);
+}
+
+#if defined(__AVX2__) && defined(__FMA__)
+template <> inline __m256d lane_broadcast<__m256d>(double a) {
+	return _mm256_set1_pd(a);
+}
+template <> inline __m256d lane_load<__m256d>(const double* p) {
+	return _mm256_loadu_pd(p);
+}
+template <> inline void lane_store<__m256d>(double* p, __m256d a) {
+	_mm256_storeu_pd(p, a);
+}
+inline __m256d lane_fms(__m256d a, __m256d b, __m256d c) {
+	return _mm256_fmsub_pd(a, b, c);
+}
+#endif
+
+#if defined(__AVX512F__)
+template <> inline __m512d lane_broadcast<__m512d>(double a) {
+	return _mm512_set1_pd(a);
+}
+template <> inline __m512d lane_load<__m512d>(const double* p) {
+	return _mm512_loadu_pd(p);
+}
+template <> inline void lane_store<__m512d>(double* p, __m512d a) {
+	_mm512_storeu_pd(p, a);
+}
+inline __m512d lane_fms(__m512d a, __m512d b, __m512d c) {
+	return _mm512_fmsub_pd(a, b, c);
+}
+#endif
+
+
+/*------------------------------- Error-Free Transformations -------------------------------*/
+
+
+// s + e = a + b exactly.
+template <class V>
+inline V two_sum(V a, V b, V& e) {
+	V s = a + b;
+	V bb = s - a;
+	e = (a - (s - bb)) + (b - bb);
+	return s;
+}
+
+// s + e = a + b exactly, if |a| >= |b|.
+template <class V>
+inline V quick_two_sum(V a, V b, V& e) {
+	V s = a + b;
+	e = b - (s - a);
+	return s;
+}
+
+// p + e = a*b exactly.
+template <class V>
+inline V two_prod(V a, V b, V& e) {
+	V p = a * b;
+	e = lane_fms(a, b, p);
+	return p;
+}
+
+
+/*------------------------------- Double-Double -------------------------------*/
+
+
+template <class V>
+struct dd_lanes {
+	V hi, lo;
+};
+
+template <class V>
+inline dd_lanes<V> dd_add(const dd_lanes<V>& a, const dd_lanes<V>& b) {
+	V s2, t2;
+	V s1 = two_sum(a.hi, b.hi, s2);
+	V t1 = two_sum(a.lo, b.lo, t2);
+	s2 = s2 + t1;
+	s1 = quick_two_sum(s1, s2, s2);
+	s2 = s2 + t2;
+	dd_lanes<V> r;
+	r.hi = quick_two_sum(s1, s2, r.lo);
+	return r;
+}
+
+template <class V>
+inline dd_lanes<V> dd_sub(const dd_lanes<V>& a, const dd_lanes<V>& b) {
+	dd_lanes<V> minus_b = {lane_broadcast<V>(0.0) - b.hi, lane_broadcast<V>(0.0) - b.lo};
+	return dd_add(a, minus_b);
+}
+
+template <class V>
+inline dd_lanes<V> dd_mul(const dd_lanes<V>& a, const dd_lanes<V>& b) {
+	V p2;
+	V p1 = two_prod(a.hi, b.hi, p2);
+	p2 = p2 + (a.hi * b.lo + a.lo * b.hi);
+	dd_lanes<V> r;
+	r.hi = quick_two_sum(p1, p2, r.lo);
+	return r;
+}
+
+template <class V>
+inline dd_lanes<V> dd_sqr(const dd_lanes<V>& a) {
+	V p2;
+	V p1 = two_prod(a.hi, a.hi, p2);
+	V two = lane_broadcast<V>(2.0);
+	p2 = p2 + two * a.hi * a.lo;
+	dd_lanes<V> r;
+	r.hi = quick_two_sum(p1, p2, r.lo);
+	return r;
+}
+
+// 2a, exact.
+template <class V>
+inline dd_lanes<V> dd_twice(const dd_lanes<V>& a) {
+	dd_lanes<V> r = {a.hi + a.hi, a.lo + a.lo};
+	return r;
+}
+
+
+/*------------------------------- Quad-Double -------------------------------*/
+
+
+template <class V>
+struct qd_lanes {
+	V c[4];
+};
+
+// (a, b, c) = a + b + c, with a the largest and c the smallest part.
+template <class V>
+inline void three_sum(V& a, V& b, V& c) {
+	V t2, t3;
+	V t1 = two_sum(a, b, t2);
+	a = two_sum(c, t1, t3);
+	b = two_sum(t2, t3, c);
+}
+
+// (a, b) = a + b + c, rounded to 2 parts.
+template <class V>
+inline void three_sum2(V& a, V& b, V& c) {
+	V t2, t3;
+	V t1 = two_sum(a, b, t2);
+	a = two_sum(c, t1, t3);
+	b = t2 + t3;
+}
+
+// Renormalize c0 + c1 + c2 + c3 + c4 to 4 non-overlapping parts, without branches such that it runs on lanes:
+// from the bottom up with quick_two_sum, then from the top down with two_sum.
+template <class V>
+inline qd_lanes<V> qd_renorm(V c0, V c1, V c2, V c3, V c4) {
+	V t1, t2, t3, t4, e;
+	V s = quick_two_sum(c3, c4, t4);
+	s = quick_two_sum(c2, s, t3);
+	s = quick_two_sum(c1, s, t2);
+	qd_lanes<V> r;
+	r.c[0] = quick_two_sum(c0, s, t1);
+	r.c[1] = two_sum(t1, t2, e);
+	r.c[2] = two_sum(e, t3, e);
+	r.c[3] = e + t4;
+	return r;
+}
+
+template <class V>
+inline qd_lanes<V> qd_add(const qd_lanes<V>& a, const qd_lanes<V>& b) {
+	V s[4], t[4];
+	for (int i = 0; i < 4; i++) {
+		s[i] = two_sum(a.c[i], b.c[i], t[i]);
+	}
+	s[1] = two_sum(s[1], t[0], t[0]);
+	three_sum(s[2], t[0], t[1]);
+	three_sum2(s[3], t[0], t[2]);
+	t[0] = t[0] + t[1] + t[3];
+	return qd_renorm(s[0], s[1], s[2], s[3], t[0]);
+}
+
+template <class V>
+inline qd_lanes<V> qd_sub(const qd_lanes<V>& a, const qd_lanes<V>& b) {
+	qd_lanes<V> minus_b;
+	for (int i = 0; i < 4; i++) {
+		minus_b.c[i] = lane_broadcast<V>(0.0) - b.c[i];
+	}
+	return qd_add(a, minus_b);
+}
+
+// The products ai*bj with i + j <= 2 exactly, and the ones with i + j = 3 in double.
+template <class V>
+inline qd_lanes<V> qd_mul(const qd_lanes<V>& a, const qd_lanes<V>& b) {
+	V q0, q1, q2, q3, q4, q5;
+	V p0 = two_prod(a.c[0], b.c[0], q0);
+	V p1 = two_prod(a.c[0], b.c[1], q1);
+	V p2 = two_prod(a.c[1], b.c[0], q2);
+	V p3 = two_prod(a.c[0], b.c[2], q3);
+	V p4 = two_prod(a.c[1], b.c[1], q4);
+	V p5 = two_prod(a.c[2], b.c[0], q5);
+
+	three_sum(p1, p2, q0);
+
+	// (s0, s1, s2) = (p2, q1, q2) + (p3, p4, p5)
+	three_sum(p2, q1, q2);
+	three_sum(p3, p4, p5);
+	V t0, t1;
+	V s0 = two_sum(p2, p3, t0);
+	V s1 = two_sum(q1, p4, t1);
+	V s2 = q2 + p5;
+	s1 = two_sum(s1, t0, t0);
+	s2 = s2 + (t0 + t1);
+
+	s1 = s1 + (a.c[0]*b.c[3] + a.c[1]*b.c[2] + a.c[2]*b.c[1] + a.c[3]*b.c[0] + q0 + q3 + q4 + q5);
+	return qd_renorm(p0, p1, s0, s1, s2);
+}
+
+// 2a, exact.
+template <class V>
+inline qd_lanes<V> qd_twice(const qd_lanes<V>& a) {
+	qd_lanes<V> r;
+	for (int i = 0; i < 4; i++) {
+		r.c[i] = a.c[i] + a.c[i];
+	}
+	return r;
+}
+
+
+/*------------------------------- Chebyshev Doubling on Double-Double & Quad-Double -------------------------------*/
+
+
+// The ladder below is written once for both number types.
+template <class V>
+inline dd_lanes<V> lanes_one(const dd_lanes<V>&) {
+	dd_lanes<V> r = {lane_broadcast<V>(1.0), lane_broadcast<V>(0.0)};
+	return r;
+}
+template <class V>
+inline qd_lanes<V> lanes_one(const qd_lanes<V>&) {
+	qd_lanes<V> r = {{lane_broadcast<V>(1.0), lane_broadcast<V>(0.0), lane_broadcast<V>(0.0), lane_broadcast<V>(0.0)}};
+	return r;
+}
+// 2a*b - c
+template <class V>
+inline dd_lanes<V> lanes_twice_mul_sub(const dd_lanes<V>& a, const dd_lanes<V>& b, const dd_lanes<V>& c) {
+	return dd_sub(dd_twice(dd_mul(a, b)), c);
+}
+template <class V>
+inline qd_lanes<V> lanes_twice_mul_sub(const qd_lanes<V>& a, const qd_lanes<V>& b, const qd_lanes<V>& c) {
+	return qd_sub(qd_twice(qd_mul(a, b)), c);
+}
+// 2a^2 - c
+template <class V>
+inline dd_lanes<V> lanes_twice_sqr_sub(const dd_lanes<V>& a, const dd_lanes<V>& c) {
+	return dd_sub(dd_twice(dd_sqr(a)), c);
+}
+template <class V>
+inline qd_lanes<V> lanes_twice_sqr_sub(const qd_lanes<V>& a, const qd_lanes<V>& c) {
+	return qd_sub(qd_twice(qd_mul(a, a)), c);
+}
+
+// Tn(x) by the (Tk, Tk+1) ladder of chebyshev_doubling, on dd_lanes or qd_lanes.
+// All the lanes have the same n, so they follow the same bits.
+template <class T>
+inline T chebyshev_doubling_lanes(const T& x, const mpz_class& n) {
+	T one = lanes_one(x);
+	T t_k = one;	//T0(x)
+	T t_k1 = x;	//T1(x)
+	// Tn(x) = T-n(x), since Tn(cos(a)) = cos(na).
+	mpz_t abs_n;
+	mpz_roinit_n(abs_n, mpz_limbs_read(n.get_mpz_t()), mpz_size(n.get_mpz_t()));
+	for (mp_bitcnt_t i = mpz_sizeinbase(abs_n, 2); i-- > 0; ) {
+		// T2k+1(x) = 2Tk(x)Tk+1(x) - x
+		T t_odd = lanes_twice_mul_sub(t_k, t_k1, x);
+		if (mpz_tstbit(abs_n, i)) {
+			t_k1 = lanes_twice_sqr_sub(t_k1, one);
+			t_k = t_odd;
+		}
+		else {
+			t_k = lanes_twice_sqr_sub(t_k, one);
+			t_k1 = t_odd;
+		}
+	}
+	return t_k;
+}
+
+// One double-double or quad-double number.
+struct dd_real {
+	double hi, lo;
+};
+
+struct qd_real {
+	double c[4];
+};
+
+// The double-double and quad-double of x, part by part: every part is the remainder truncated to a double.
+dd_real mpf_to_dd(const mpf_class& x);
+qd_real mpf_to_qd(const mpf_class& x);
+
+// The exact value of a double-double or quad-double (precision 1100 bits covers the exponents of the parts).
+mpf_class dd_to_mpf(const dd_real& a);
+mpf_class qd_to_mpf(const qd_real& a);
+
+// Tn(x) on one double-double or quad-double, the scalar reference of the batches.
+dd_real chebyshev_doubling_dd(const dd_real& x, const mpz_class& n);
+qd_real chebyshev_doubling_qd(const qd_real& x, const mpz_class& n);
+
+// result_list[i] = Tn(x_list[i]) for i < count, DD_LANES at a time, and the last ones with the scalar code.
+void chebyshev_doubling_dd_batch(const dd_real* x_list, int count, const mpz_class& n, dd_real* result_list);
+void chebyshev_doubling_qd_batch(const qd_real* x_list, int count, const mpz_class& n, qd_real* result_list);
+
+// Tn(x) at the precision of ctx on the smallest engine with enough bits: double-double up to DD_MAX_PREC bits,
+// quad-double up to QD_MAX_PREC bits, and chebyshev_doubling on mpf above. The result has the precision of ctx.
+// For |x| > 1, or a result that overflows a double, it is chebyshev_doubling on mpf as well.
+// For chebyshev_dd_benchmark only: the engines compute at 106 or 212 bits whatever m is, so the relation probes of
+// l, m and s stay on mpf.
+mpf_class chebyshev_doubling_small(chebyshev_context& ctx, const mpf_class& x, const mpz_class& n);
+
+#endif
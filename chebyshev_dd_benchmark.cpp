@@ -0,0 +1,176 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This program runs the parameter study of chebyshev_gmp_relation at small precisions on the double-double and
+// quad-double engine of chebyshev_dd.hpp, which chebyshev_doubling_small chooses from m (double-double up to
+// 32 digits, quad-double up to 65 digits), next to the mpf engine chebyshev_doubling.
+// First, for s = 10, 10^2, 10^4, ... it decrypts u with both engines and prints the differences, until both fail.
+// Second, it measures the probes per second, a probe being one Ts(x) with s = 10^length, for <number of probes>
+// different x in (-1, 1): with mpf, with one double-double or quad-double at a time, and with the lanes of
+// chebyshev_doubling_dd_batch or chebyshev_doubling_qd_batch; and the largest error against mpf with twice the precision.
+// mpf rounds its precision up to whole limbs and keeps one more limb, so at the same m it carries more bits
+// than the engine and supports a larger s: the engine is the one that holds m digits exactly.
+// The lanes need -march=native (AVX2 or AVX-512), otherwise they are the scalar code.
+
+// In order to compile and run this program, you need to install two libraries: GMP and MPFR.
+// Compile: g++ -O2 -march=native -o chebyshev_dd_benchmark chebyshev_dd_benchmark.cpp chebyshev.cpp chebyshev_dd.cpp -lmpfr -lgmpxx -lgmp
+// Run: ./chebyshev_dd_benchmark <precision l> <precision m> <length of s> <number of probes> (m at most 65)
+#include <iostream>
+#include <string>
+#include <random>
+
+#include <gmpxx.h>
+#include <mpreal.h>
+#include "chebyshev.hpp"
+#include "chebyshev_dd.hpp"
+
+#include <time.h>
+
+using namespace std;
+
+// u recovered from z0 = Tr(x), z2 = u*Tr(Ts(x)), r = s - 1, with the Chebyshev engine evaluation.
+mpf_class decrypt_relation(chebyshev_context& ctx, const mpf_class& x, const mpf_class& u, const mpz_class& s,
+		mpf_class (*evaluation)(chebyshev_context&, const mpf_class&, const mpz_class&)) {
+	mpz_class r = s - 1;
+	mpf_class y = evaluation(ctx, x, s);
+	mpf_class z0 = evaluation(ctx, x, r);
+	mpf_class z2(u * evaluation(ctx, y, r), ctx.prec);
+	mpf_class Ts_z0 = evaluation(ctx, z0, s);
+	return mpf_class(z2 / Ts_z0, ctx.prec);
+}
+
+int main (int argc, char* argv[]) {
+	int n_digits_l, n_digits_m, n_s, n_probes;
+	if (argc == 5) {
+		n_digits_l = atoi(argv[1]);
+		n_digits_m = atoi(argv[2]);
+		n_s = atoi(argv[3]);
+		n_probes = atoi(argv[4]);
+	}
+	else {
+		cout << "Notice: If you want to run this program, you need 4 inputs, such that: " << endl;
+		cout << "Example: ./chebyshev_dd_benchmark <precision l> <precision m> <length of s> <number of probes> (m at most 65) " << endl;
+		cout << "For example: ./chebyshev_dd_benchmark 25 30 8 4096" << endl;
+		return 0;
+	}
+
+	mp_bitcnt_t prec_l = digits2bit_mpf(n_digits_l);
+	mp_bitcnt_t prec_m = digits2bit_mpf(n_digits_m);
+	chebyshev_context ctx(prec_m);
+	string engine = (prec_m <= 104) ? "double-double" : (prec_m <= 208 ? "quad-double" : "mpf");
+	cout << "l = " << n_digits_l << " digits, m = " << n_digits_m << " digits (" << prec_m << " bits), engine: " << engine;
+	cout << ", lanes: " << dd_lane_name() << endl;
+
+
+	/*----------------------------------- Relation between l, m and s -----------------------------------*/
+
+
+	// x = 0.111..., u = 0.0101... and error = 10^-l, as in chebyshev_gmp_relation.
+	string x_string = "1", u_string = "01", error_string = "0";
+	while (x_string.length() < n_digits_l)
+		x_string += "1";
+	while (u_string.length() < n_digits_l)
+		u_string += "01";
+	while (error_string.length() < n_digits_l - 1)
+		error_string += "0";
+	mpf_class x(0, prec_l), u(0, prec_l), error(0, prec_l);
+	x.set_str("0." + x_string, 10);
+	u.set_str("0." + u_string, 10);
+	error.set_str("0." + error_string + "1", 10);
+
+	cout.precision(6);
+	cout << endl << "length of s, mpf difference, " << engine << " difference" << endl;
+	mpz_class s = 10;
+	long length = 1;
+	bool mpf_success = true, small_success = true;
+	while (mpf_success || small_success) {
+		mpf_class difference_mpf = abs(u - decrypt_relation(ctx, x, u, s, chebyshev_doubling));
+		mpf_class difference_small = abs(u - decrypt_relation(ctx, x, u, s, chebyshev_doubling_small));
+		mpf_success = difference_mpf < error;
+		small_success = difference_small < error;
+		cout << length << ", " << difference_mpf.get_d() << (mpf_success ? "" : " (fail)") << ", ";
+		cout << difference_small.get_d() << (small_success ? "" : " (fail)") << endl;
+		s *= s;
+		length *= 2;
+	}
+
+
+	/*----------------------------------- Probes per Second -----------------------------------*/
+
+
+	mpz_ui_pow_ui(s.get_mpz_t(), 10, n_s);
+	mt19937_64 generator(2026);
+	uniform_real_distribution<double> uniform(-1.0, 1.0);
+	mpf_class* x_list = new mpf_class[n_probes];
+	dd_real* x_dd = new dd_real[n_probes];
+	dd_real* y_dd = new dd_real[n_probes];
+	qd_real* x_qd = new qd_real[n_probes];
+	qd_real* y_qd = new qd_real[n_probes];
+	for (int i = 0; i < n_probes; i++) {
+		// x with all m digits: a double plus a smaller random double, rounded to m digits.
+		x_list[i] = mpf_class(uniform(generator), prec_m);
+		x_list[i] += mpf_class(uniform(generator), prec_m) * 1e-17;
+		x_dd[i] = mpf_to_dd(x_list[i]);
+		x_qd[i] = mpf_to_qd(x_list[i]);
+	}
+
+	clock_t start, end;
+	mpf_class y;
+	start = clock();
+	for (int i = 0; i < n_probes; i++) {
+		y = chebyshev_doubling(ctx, x_list[i], s);
+	}
+	end = clock();
+	double time_mpf = double(end - start)/CLOCKS_PER_SEC;
+
+	bool use_dd = (prec_m <= 104);
+	start = clock();
+	for (int i = 0; i < n_probes; i++) {
+		if (use_dd) {
+			y_dd[i] = chebyshev_doubling_dd(x_dd[i], s);
+		}
+		else {
+			y_qd[i] = chebyshev_doubling_qd(x_qd[i], s);
+		}
+	}
+	end = clock();
+	double time_scalar = double(end - start)/CLOCKS_PER_SEC;
+
+	start = clock();
+	if (use_dd) {
+		chebyshev_doubling_dd_batch(x_dd, n_probes, s, y_dd);
+	}
+	else {
+		chebyshev_doubling_qd_batch(x_qd, n_probes, s, y_qd);
+	}
+	end = clock();
+	double time_lanes = double(end - start)/CLOCKS_PER_SEC;
+
+	// The largest error of the lanes against mpf with twice the precision, and of mpf at m itself.
+	chebyshev_context reference(2*prec_m + 64);
+	mpf_class error_lanes = 0, error_mpf = 0;
+	for (int i = 0; i < n_probes; i++) {
+		mpf_class x_reference(x_list[i], 2*prec_m + 64);
+		mpf_class y_reference = chebyshev_doubling(reference, x_reference, s);
+		mpf_class y_lanes = use_dd ? dd_to_mpf(y_dd[i]) : qd_to_mpf(y_qd[i]);
+		mpf_class e_lanes = abs(y_lanes - y_reference);
+		mpf_class e_mpf = abs(chebyshev_doubling(ctx, x_list[i], s) - y_reference);
+		if (e_lanes > error_lanes)
+			error_lanes = e_lanes;
+		if (e_mpf > error_mpf)
+			error_mpf = e_mpf;
+	}
+
+	cout << endl << "s = 10^" << n_s << ", " << n_probes << " probes" << endl;
+	cout << "engine, probes/s, speedup against mpf, largest error" << endl;
+	cout << "mpf, " << n_probes / time_mpf << ", 1, " << error_mpf.get_d() << endl;
+	cout << engine << " scalar, " << n_probes / time_scalar << ", " << time_mpf / time_scalar << ", " << error_lanes.get_d() << endl;
+	cout << engine << " lanes, " << n_probes / time_lanes << ", " << time_mpf / time_lanes << ", " << error_lanes.get_d() << endl;
+
+	delete[] x_list;
+	delete[] x_dd;
+	delete[] y_dd;
+	delete[] x_qd;
+	delete[] y_qd;
+	return 0;
+}
@@ -19,6 +19,34 @@
 
 using namespace std;
 
+// The calculations of count_total from the tallies of count_detailed: every tmp*tmp has 2 squarings, so squarings/2 of them,
+// then a step is 1 multiplication and 1 addition and u*v is 8 and 4, which give the steps and the products u*v apart.
+uint64_t detailed_to_total(const count_detailed& detailed) {
+	uint64_t squares = detailed.squarings / 2;
+	uint64_t products = (detailed.multiplications - detailed.additions - 2*squares) / 4;
+	uint64_t steps = detailed.additions - 4*squares - 4*products;
+	return steps + 2*squares + 2*products;
+}
+
+// Whether count_detailed and count_total agree on Tn(x) for n = 1 to n_last, for both methods, with the same result.
+bool check_count_policies(const mpf_class& x, int n_last) {
+	for (int n = 1; n <= n_last; n++) {
+		count_total total_expensive, total_economical;
+		count_detailed detailed_expensive, detailed_economical;
+		mpf_class a = chebyshev_expensive_policy(x, mpz_class(n), total_expensive);
+		mpf_class b = chebyshev_expensive_policy(x, mpz_class(n), detailed_expensive);
+		mpf_class c = chebyshev_economical_policy(x, mpz_class(n), total_economical);
+		mpf_class d = chebyshev_economical_policy(x, mpz_class(n), detailed_economical);
+		if (a != b || c != d || detailed_to_total(detailed_expensive) != total_expensive.calculations
+				|| detailed_to_total(detailed_economical) != total_economical.calculations
+				|| detailed_expensive.squarings != 0 || detailed_expensive.multiplications != uint64_t(n)) {
+			cout << "count_detailed does not match count_total for n = " << n << endl;
+			return false;
+		}
+	}
+	return true;
+}
+
 int main (int argc, char* argv[]) {
 	int n_digits_l, n_digits_m;
 	if (argc == 3) {
@@ -82,6 +110,13 @@ int main (int argc, char* argv[]) {
 	cout << "Precision m of mpf for computation is: " << mpf_get_default_prec() << ", where 3.2 bit represents one decimal digit in average. ";
 	cout << "Which is " << int(mpf_get_default_prec() / 3.2) << " digits." << endl << endl;
 	
+	// The detailed counts of the operations must add up to the calculations we report.
+	int n_check = 1000;
+	if (!check_count_policies(x, n_check)) {
+		return 1;
+	}
+	cout << "count_detailed matches count_total for n = 1 to " << n_check << endl << endl;
+
 	mpz_class s = 10;
 	mpz_class r = s / 2;
 
@@ -61,10 +61,8 @@ int main (int argc, char* argv[]) {
 
 	cout << "Convert Message to Plaintxt with " << char_n_per_group << " chars for ASCII per group in [0,1], where 8 digits represent 1 char:" << endl;
 	// Convert string to floating numbers.
-	mpf_class* u_list = new mpf_class[binary_list_n];
+	mpf_class* u_list = binary_list_to_u_list(binary_list, binary_list_n, digits2bit_mpf(n_digits_l));
 	for (int i = 0; i < binary_list_n; i++) {
-		u_list[i].set_str(binary_list[i], 10);
-
 		// Change precision of cout in order to see more digits
 		cout.precision(count_digits_mpf_decimal(u_list[i]));
 		cout << u_list[i] << endl;
@@ -115,40 +113,28 @@ int main (int argc, char* argv[]) {
 	}
 	cout << "with r = " << r << endl;
 
-	mpf_class Ts_z0 = chebyshev_economical(z0, s);
+	// Every block has the same z0, so the session computes Ts(z0) once and each block is one multiplication.
+	decryption_session session(s, digits2bit_mpf(n_digits_m));
 	
 	// Recover plaintext:
 	cout << endl << "Recover Plaintxt u = z2/Ts(z0) = " << endl;
 	mpf_class* u_list_recover = new mpf_class[binary_list_n];
 	for (int i = 0; i < binary_list_n; i++) {
-		u_list_recover[i] = z2_list[i] / Ts_z0;
+		u_list_recover[i] = session_decrypt(session, z0, z2_list[i]);
 
 		// Change precision of cout in order to see more digits
 		cout.precision(count_digits_mpf_decimal(u_list_recover[i]));
 		cout << u_list_recover[i] << endl;
 	}
+	cout << "Ts(z0) computed " << session.misses << " time(s) for " << session.hits + session.misses << " blocks" << endl;
 
 	/*----------------------------------- Convert Floating Numbers to ASCII chars -----------------------------------*/
 
 	int neccessary_digits = char_n_per_group * 8;
 	cout << endl << "Took neccessary digits for each block, here is " << neccessary_digits << ", which represents " << char_n_per_group << " ASCII chars in binary: " << endl;
 	//Convert floating numbers to string again.
-	string* binary_list_recover = new string[binary_list_n];
-	mpz_class tmp;
-	mp_exp_t power;
+	string* binary_list_recover = u_list_to_binary_list(u_list_recover, binary_list_n, char_n_per_group);
 	for (int i = 0; i < binary_list_n; i++) {
-		//get_str() returns an integer form string with an variable represent power.
-		//Example: "3.1415" -> "31415" with power = 1.
-		power = 0;
-		binary_list_recover[i] = u_list_recover[i].get_str(power, 10, char_n_per_group*8+2);
-		//Add missing 0's at the front.
-		for (int j = power; j < 0; j++) {
-			binary_list_recover[i] = "0" + binary_list_recover[i];
-		}
-		//Add the missing 0's at the end of floating numbers.
-		while (binary_list_recover[i].length()%8 != 0) {
-			binary_list_recover[i] += '0';
-		}
 		cout << binary_list_recover[i] << endl;
 	}
 
@@ -0,0 +1,139 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This program aims test the encryption & decryption of the blocking method with a fresh r for every block,
+// on a work-stealing thread pool, and measures how the throughput scales from 1 thread to all cores.
+// The message is encryption_message.txt repeated until it has the given size in MB, then every thread number
+// 1, 2, 4, ..., up to the largest number of threads encrypts and decrypts it, and checks the recovered message.
+
+// In order to compile and run this program, you need to install two libraries: GMP and MPFR.
+// Compile: g++ -o chebyshev_encryption_block_parallel chebyshev_encryption_block_parallel.cpp chebyshev.cpp chebyshev_parallel.cpp -lmpfr -lgmpxx -lgmp -pthread
+// Run: ./chebyshev_encryption_block_parallel <precision l> <precision m> <size of message in MB> <largest number of threads> (0 threads for all cores)
+#include <iostream>
+#include <string>
+#include <fstream>
+#include <chrono>
+#include <random>
+
+#include <gmpxx.h>
+#include <mpreal.h>
+#include "chebyshev.hpp"
+#include "chebyshev_parallel.hpp"
+
+using namespace std;
+
+int main (int argc, char* argv[]) {
+	int n_digits_l, n_digits_m, max_threads_n;
+	double message_mb;
+	if (argc == 5) {
+		n_digits_l = atoi(argv[1]);
+		n_digits_m = atoi(argv[2]);
+		message_mb = atof(argv[3]);
+		max_threads_n = atoi(argv[4]);
+	}
+	else {
+		cout << "Notice: If you want to run this program, you need 4 inputs, such that: " << endl;
+		cout << "Example: ./chebyshev_encryption_block_parallel <precision l> <precision m> <size of message in MB> <largest number of threads> (0 threads for all cores) " << endl;
+		cout << "For example: ./chebyshev_encryption_block_parallel 100 120 1 0" << endl;
+		return 0;
+	}
+	if (max_threads_n <= 0) {
+		max_threads_n = hardware_threads();
+	}
+
+	/*----------------------------------- Manipulation of Plaintext from ASCII to Floating Numbers with Binary Form -----------------------------------*/
+
+	ifstream file ("encryption_message.txt");
+	string text = "";
+	string line;
+	while (getline(file, line)) {
+		text += line;
+		text += "\n";
+	}
+	file.close();
+	if (text.empty()) {
+		cout << "encryption_message.txt is empty or missing!" << endl;
+		return 1;
+	}
+
+	size_t message_length = size_t(message_mb * 1024 * 1024);
+	string message;
+	message.reserve(message_length);
+	while (message.length() < message_length) {
+		message += text.substr(0, message_length - message.length());
+	}
+
+	mp_bitcnt_t prec_l = digits2bit_mpf(n_digits_l);
+	mp_bitcnt_t prec_m = digits2bit_mpf(n_digits_m);
+	int char_n_per_group = int((n_digits_l) / 8);
+	int binary_list_n = int(message.length() / char_n_per_group) + 1;
+	string* binary_list = message_to_binary_list(message, binary_list_n, char_n_per_group);
+	mpf_class* u_list = binary_list_to_u_list(binary_list, binary_list_n, prec_l);
+	delete[] binary_list;
+
+	cout << "Message of " << message.length() << " chars, " << binary_list_n << " blocks of " << char_n_per_group << " chars." << endl;
+	cout << "Precision l = " << prec_l << " bits, precision m = " << prec_m << " bits." << endl;
+
+	/*----------------------------------- Key Generation -----------------------------------*/
+
+	// Choose s as 10^8 for m = 120, by the experiment we did in "chehyshev_gmp_relation.cpp"
+	mpz_class s = 1;
+	for (int i = 0; i < 8; i++) {
+		s *= 10;
+	}
+
+	chebyshev_context ctx(prec_m);
+	string tmp_string = "1";
+	string x_string = "1";
+	while (x_string.length() < n_digits_m)
+		x_string += tmp_string;
+	mpf_class x = context_mpf(ctx, "0." + x_string);
+	mpf_class y = chebyshev_doubling(ctx, x, s);
+
+	// The nonces of the blocks come from this seed.
+	random_device device;
+	mpz_class seed = device();
+	seed = (seed << 32) + device();
+
+	/*----------------------------------- Start Experiment -----------------------------------*/
+
+	mpf_class* z0_list = new mpf_class[binary_list_n];
+	mpf_class* z2_list = new mpf_class[binary_list_n];
+	mpf_class* u_list_recover = new mpf_class[binary_list_n];
+	double time_one_thread = 0;
+
+	cout.precision(6);
+	cout << endl << "threads, encryption time, decryption time, MB/s, speedup, recovered" << endl;
+	// 1, 2, 4, ... threads, and at last the largest number of threads.
+	for (int threads_n = 1; threads_n <= max_threads_n; threads_n = (threads_n == max_threads_n) ? threads_n + 1 : min(2*threads_n, max_threads_n)) {
+		thread_pool pool(threads_n);
+
+		auto start = chrono::steady_clock::now();
+		block_encrypt_parallel(pool, prec_m, x, y, s, seed, u_list, binary_list_n, z0_list, z2_list);
+		auto middle = chrono::steady_clock::now();
+		block_decrypt_parallel(pool, prec_m, s, z0_list, z2_list, binary_list_n, u_list_recover);
+		auto end = chrono::steady_clock::now();
+
+		double time_encryption = chrono::duration<double>(middle - start).count();
+		double time_decryption = chrono::duration<double>(end - middle).count();
+		double time_total = time_encryption + time_decryption;
+		if (threads_n == 1) {
+			time_one_thread = time_total;
+		}
+
+		string* binary_list_recover = u_list_to_binary_list(u_list_recover, binary_list_n, char_n_per_group);
+		string message_recover = binary_list_to_message(binary_list_recover, binary_list_n);
+		delete[] binary_list_recover;
+
+		cout << threads_n << ", " << time_encryption << "s, " << time_decryption << "s, ";
+		cout << message.length() / 1024.0 / 1024.0 / time_total << ", " << time_one_thread / time_total << ", ";
+		cout << (message_recover == message ? "yes" : "no") << endl;
+	}
+
+	delete[] u_list;
+	delete[] z0_list;
+	delete[] z2_list;
+	delete[] u_list_recover;
+
+	return 0;
+}
@@ -0,0 +1,161 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This program encrypts or decrypts a file of any size with the blocking method, a fresh r for every block.
+// The bytes are packed in the plaintexts u either as decimal digits "0"/"1" (decimal, l/8 bytes per block),
+// or directly as the binary digits of the mantissa (binary, about l*log2(10)/8 bytes per block, 3.3 times less blocks).
+// The file is read by chunks of STREAM_CHUNK_BLOCKS blocks, and every chunk is encrypted on the thread pool and written
+// before the next one is read, so the memory stays the same for a file of 1 MB or of many GB.
+// The key is the one of chebyshev_encryption_block.cpp: x = 0.111... with m digits and s = 10^8,
+// so the same l and m must be given to encrypt and to decrypt.
+// With m = 0, m is the smallest one of the calibration table (chebyshev_calibration.hpp) for l and s = 10^8,
+// read from CHEBYSHEV_CALIBRATION or chebyshev_calibration.bin, so the same table must be there to decrypt.
+// With m = auto, encrypt chooses m from the error bound (choose_precision of chebyshev_adaptive.hpp) below 10^-l for
+// s = 10^8 and r = s - 1, plus ADAPTIVE_MARGIN_DIGITS digits for the other r, and the header of the ciphertext keeps it,
+// so decrypt takes m = auto as well and reads it there.
+// At the end it prints the number of bytes, the time, the MB/s and the peak memory of the process.
+
+// In order to compile and run this program, you need to install two libraries: GMP and MPFR.
+// Compile: g++ -o chebyshev_encryption_stream chebyshev_encryption_stream.cpp chebyshev.cpp chebyshev_parallel.cpp chebyshev_calibration.cpp chebyshev_adaptive.cpp -lmpfr -lgmpxx -lgmp -pthread
+// Run: ./chebyshev_encryption_stream <encrypt/decrypt> <input file> <output file> <precision l> <precision m> <number of threads> <packing decimal/binary> (0 threads for all cores, m = 0 for the calibration table, m = auto for the error bound)
+#include <iostream>
+#include <string>
+#include <fstream>
+#include <chrono>
+#include <random>
+
+#include <gmpxx.h>
+#include <mpreal.h>
+#include "chebyshev.hpp"
+#include "chebyshev_parallel.hpp"
+#include "chebyshev_calibration.hpp"
+#include "chebyshev_adaptive.hpp"
+
+#include <sys/resource.h>
+
+using namespace std;
+
+int main (int argc, char* argv[]) {
+	string mode, input_path, output_path, packing_name;
+	int n_digits_l, n_digits_m, threads_n;
+	bool adaptive = false;
+	if (argc == 8) {
+		mode = argv[1];
+		input_path = argv[2];
+		output_path = argv[3];
+		n_digits_l = atoi(argv[4]);
+		n_digits_m = atoi(argv[5]);
+		adaptive = (string(argv[5]) == "auto");
+		threads_n = atoi(argv[6]);
+		packing_name = argv[7];
+	}
+	if (argc != 8 || (mode != "encrypt" && mode != "decrypt") || (packing_name != "decimal" && packing_name != "binary")) {
+		cout << "Notice: If you want to run this program, you need 7 inputs, such that: " << endl;
+		cout << "Example: ./chebyshev_encryption_stream <encrypt/decrypt> <input file> <output file> <precision l> <precision m> <number of threads> <packing decimal/binary> (0 threads for all cores, m = 0 for the calibration table, m = auto for the error bound) " << endl;
+		cout << "For example: ./chebyshev_encryption_stream encrypt encryption_message.txt message.chebyshev 100 120 0 binary" << endl;
+		cout << "And then:    ./chebyshev_encryption_stream decrypt message.chebyshev message.txt 100 120 0 binary" << endl;
+		cout << "(decrypt reads the packing from the ciphertext)" << endl;
+		return 0;
+	}
+	if (threads_n <= 0) {
+		threads_n = hardware_threads();
+	}
+
+	ifstream in(input_path, ios::binary);
+	if (!in) {
+		cout << "Cannot open " << input_path << endl;
+		return 1;
+	}
+	ofstream out(output_path, ios::binary);
+	if (!out) {
+		cout << "Cannot open " << output_path << endl;
+		return 1;
+	}
+
+	/*----------------------------------- Key Generation -----------------------------------*/
+
+	// Choose s as 10^8 for m = 120, by the experiment we did in "chehyshev_gmp_relation.cpp"
+	mpz_class s = 1;
+	for (int i = 0; i < 8; i++) {
+		s *= 10;
+	}
+
+	if (adaptive && mode == "decrypt") {
+		// stream_decrypt takes m from the header of the ciphertext, m only gives the public key, which decrypt does not use.
+		n_digits_m = n_digits_l;
+	}
+	else if (adaptive) {
+		// The bound grows with |u|, so u = 1 bounds every block. Every block has its own r between s/2 and s, and
+		// r = s - 1 stands for all of them, which is a heuristic: hence ADAPTIVE_MARGIN_DIGITS more digits.
+		// The key x has m digits itself, so m grows until it is enough for the x of m digits.
+		adaptive_precision chosen;
+		n_digits_m = 0;
+		int next_m = n_digits_l;
+		while (next_m > n_digits_m) {
+			n_digits_m = next_m;
+			mpf_class x_m(0, digits2bit_mpf(n_digits_m));
+			x_m.set_str("0." + string(n_digits_m, '1'), 10);
+			chosen = choose_precision(n_digits_l, x_m, mpf_class(1), s, s - 1);
+			next_m = chosen.n_digits_m + ADAPTIVE_MARGIN_DIGITS;
+		}
+		cout.precision(6);
+		cout << "m = " << n_digits_m << " from the error bound " << chosen.bound << " < 10^-" << n_digits_l << " at m = "
+				<< chosen.n_digits_m << endl;
+	}
+	else if (n_digits_m == 0) {
+		n_digits_m = calibration_min_precision(calibration_default(), n_digits_l, 8);
+		if (n_digits_m == 0) {
+			cout << "The calibration table has no m for l = " << n_digits_l << " and s = 10^8!" << endl;
+			return 1;
+		}
+		cout << "m = " << n_digits_m << " from the calibration table" << endl;
+	}
+	mp_bitcnt_t prec_l = digits2bit_mpf(n_digits_l);
+	mp_bitcnt_t prec_m = digits2bit_mpf(n_digits_m);
+	plaintext_packing packing = (packing_name == "binary") ? PACKING_BINARY : PACKING_DECIMAL;
+	int char_n_per_group = (packing == PACKING_BINARY) ? packed_bytes_per_group(n_digits_l) : int((n_digits_l) / 8);
+
+	chebyshev_context ctx(prec_m);
+	string tmp_string = "1";
+	string x_string = "1";
+	while (x_string.length() < n_digits_m)
+		x_string += tmp_string;
+	mpf_class x = context_mpf(ctx, "0." + x_string);
+	mpf_class y = chebyshev_doubling(ctx, x, s);
+
+	/*----------------------------------- Start Experiment -----------------------------------*/
+
+	thread_pool pool(threads_n);
+	long long bytes_n;
+	auto start = chrono::steady_clock::now();
+	if (mode == "encrypt") {
+		// The nonces of the blocks come from this seed.
+		random_device device;
+		mpz_class seed = device();
+		seed = (seed << 32) + device();
+		bytes_n = stream_encrypt(pool, packing, char_n_per_group, prec_l, prec_m, x, y, s, seed, in, out);
+	}
+	else {
+		bytes_n = stream_decrypt(pool, s, in, out);
+	}
+	out.close();
+	auto end = chrono::steady_clock::now();
+
+	if (bytes_n < 0) {
+		cout << input_path << " is not a ciphertext of chebyshev_encryption_stream!" << endl;
+		return 1;
+	}
+
+	double time = chrono::duration<double>(end - start).count();
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	cout.precision(6);
+	cout << mode << ": " << bytes_n << " bytes of plaintext with " << threads_n << " threads, ";
+	if (mode == "encrypt") {
+		cout << packing_name << " packing of " << char_n_per_group << " bytes per block, ";
+	}
+	cout << time << "s, ";
+	cout << bytes_n / 1024.0 / 1024.0 / time << " MB/s, peak memory " << usage.ru_maxrss / 1024 << " MB" << endl;
+
+	return 0;
+}
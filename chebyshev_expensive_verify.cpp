@@ -0,0 +1,79 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This program is the segmented, parallel version of the reference of chebyshev_economical_test: the expensive method
+// for Tn(x), with x = 0.111... of l digits, is split into <segments> ranges run on <threads> threads by
+// chebyshev_expensive_segmented of chebyshev_parallel.hpp. Every range starts from seeds of the economical method with
+// twice the digits of m, runs its steps at m digits, and is compared with the economical method at twice the digits at
+// its end, so a range checks the steps of the expensive method at m digits, and n = 10^9 takes minutes instead of a day.
+// The program prints one CSV row per range, the largest divergence, and the difference between chebyshev_economical
+// at m digits (the path the test validates) and the reference Tn(x).
+
+// In order to compile and run this program, you need to install two libraries: GMP and MPFR.
+// Compile: g++ -o chebyshev_expensive_verify chebyshev_expensive_verify.cpp chebyshev.cpp chebyshev_parallel.cpp -lmpfr -lgmpxx -lgmp -pthread
+// Run: ./chebyshev_expensive_verify <precision l> <precision m> <degree n> <segments> <threads>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include <gmpxx.h>
+#include <mpreal.h>
+#include "chebyshev.hpp"
+#include "chebyshev_parallel.hpp"
+
+using namespace std;
+
+int main (int argc, char* argv[]) {
+	int n_digits_l = 0, n_digits_m = 0, segments_n = 0, threads_n = -1;
+	mpz_class n;
+	bool n_valid = false;
+	if (argc == 6) {
+		n_digits_l = atoi(argv[1]);
+		n_digits_m = atoi(argv[2]);
+		n_valid = (n.set_str(argv[3], 10) == 0 && n > 0);
+		segments_n = atoi(argv[4]);
+		threads_n = atoi(argv[5]);
+	}
+	if (argc != 6 || !n_valid || n_digits_l <= 0 || n_digits_m <= 0 || segments_n <= 0 || threads_n < 0) {
+		cout << "Notice: If you want to run this program, you need 5 inputs, such that: " << endl;
+		cout << "Example: ./chebyshev_expensive_verify <precision l> <precision m> <degree n> <segments> <threads> ";
+		cout << "(threads 0 for all the cores) " << endl;
+		cout << "For example: ./chebyshev_expensive_verify 100 120 1000000000 256 0" << endl;
+		return 0;
+	}
+	if (threads_n == 0) {
+		threads_n = hardware_threads();
+	}
+
+	mp_bitcnt_t prec = digits2bit_mpf(n_digits_m);
+	mp_bitcnt_t seed_prec = digits2bit_mpf(2*n_digits_m);
+
+	// Choose x as 0.1111... with precision l number of digits.
+	string x_string = "1";
+	while (x_string.length() < n_digits_l)
+		x_string += "1";
+	mpf_class x(0, digits2bit_mpf(n_digits_l));
+	x.set_str("0." + x_string, 10);
+
+	thread_pool pool(threads_n);
+	vector<expensive_segment> segments;
+	auto start = chrono::steady_clock::now();
+	mpf_class largest = chebyshev_expensive_segmented(pool, prec, seed_prec, x, n, segments_n, segments);
+	double wall = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	chebyshev_context ctx(prec);
+	mpf_class economical = chebyshev_economical(ctx, mpf_class(x, prec), n);
+	mpf_class economical_difference = abs(economical - segments.back().reference);
+
+	cout.precision(6);
+	cout << "first,last,divergence,seconds" << endl;
+	for (expensive_segment& segment : segments) {
+		cout << segment.first << "," << segment.last << "," << segment.divergence << "," << segment.seconds << endl;
+	}
+	cout << "n = " << n << ", " << segments.size() << " segments on " << threads_n << " threads, " << wall << "s" << endl;
+	cout << "Largest divergence of the expensive method at m digits = " << largest << endl;
+	cout << "Difference of the economical method at m digits = " << economical_difference << endl;
+
+	return 0;
+}
@@ -0,0 +1,253 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This Program is the Fixed-Point Part of the Library of our Chebyshev Article:
+// Tn(x) for |x| <= 1 on mpz numbers scaled by 2^F. See chebyshev_fixed.hpp for the error bound.
+#include <iostream>
+#include <string>
+
+#include <gmpxx.h>
+#include "chebyshev.hpp"
+#include "chebyshev_fixed.hpp"
+
+using namespace std;
+
+
+/*------------------------------- Fixed-Point Numbers -------------------------------*/
+
+
+fixed_context::fixed_context(mp_bitcnt_t frac_bits) : frac_bits(frac_bits) {
+	mp_bitcnt_t bits = 2*frac_bits + 2*GMP_NUMB_BITS;
+	for (int i = 0; i < 3; i++) {
+		mpz_init2(t[i], bits);
+		mpz_init2(scratch[i], bits);
+	}
+	mpz_init2(product, bits);
+	for (int i = 0; i < 4; i++) {
+		mpz_init2(mx[i], bits);
+		mpz_init2(power[i], bits);
+	}
+}
+
+fixed_context::~fixed_context() {
+	for (int i = 0; i < 3; i++) {
+		mpz_clear(t[i]);
+		mpz_clear(scratch[i]);
+	}
+	mpz_clear(product);
+	for (int i = 0; i < 4; i++) {
+		mpz_clear(mx[i]);
+		mpz_clear(power[i]);
+	}
+}
+
+void mpf_to_fixed(mpz_t v, const mpf_t x, mp_bitcnt_t frac_bits) {
+	mpf_t scaled;
+	mpf_init2(scaled, mpf_get_prec(x) + frac_bits);
+	mpf_mul_2exp(scaled, x, frac_bits);
+	mpf_floor(scaled, scaled);
+	mpz_set_f(v, scaled);
+	mpf_clear(scaled);
+}
+
+void fixed_to_mpf(mpf_t x, const mpz_t v, mp_bitcnt_t frac_bits) {
+	mpf_set_z(x, v);
+	mpf_div_2exp(x, x, frac_bits);
+}
+
+void fixed_mul(fixed_context& ctx, mpz_t r, const mpz_t a, const mpz_t b) {
+	mpz_mul(ctx.product, a, b);
+	mpz_fdiv_q_2exp(r, ctx.product, ctx.frac_bits);
+}
+
+void fixed_sqr(fixed_context& ctx, mpz_t r, const mpz_t a) {
+	mpz_mul(ctx.product, a, a);
+	mpz_fdiv_q_2exp(r, ctx.product, ctx.frac_bits);
+}
+
+// u = Mx = [0, -1; 1, 2x], with one = 2^F.
+void fixed_matrix_set_mx(fixed_context& ctx, mpz_t* u, const mpz_t x) {
+	mpz_set_ui(u[0], 0);
+	mpz_set_ui(u[1], 1);
+	mpz_mul_2exp(u[1], u[1], ctx.frac_bits);
+	mpz_neg(u[1], u[1]);
+	mpz_neg(u[2], u[1]);
+	mpz_mul_2exp(u[3], x, 1);
+}
+
+// u = u*v, in place, as matrix_mpf_multiplication.
+void fixed_matrix_multiplication(fixed_context& ctx, mpz_t* u, mpz_t* v) {
+	mpz_t* s = ctx.scratch;
+	fixed_mul(ctx, s[0], u[0], v[0]);
+	fixed_mul(ctx, s[2], u[1], v[2]);
+	mpz_add(s[0], s[0], s[2]);
+	fixed_mul(ctx, s[1], u[0], v[1]);
+	fixed_mul(ctx, s[2], u[1], v[3]);
+	mpz_add(s[1], s[1], s[2]);
+	mpz_swap(u[0], s[0]);
+	mpz_swap(u[1], s[1]);
+
+	fixed_mul(ctx, s[0], u[2], v[0]);
+	fixed_mul(ctx, s[2], u[3], v[2]);
+	mpz_add(s[0], s[0], s[2]);
+	fixed_mul(ctx, s[1], u[2], v[1]);
+	fixed_mul(ctx, s[2], u[3], v[3]);
+	mpz_add(s[1], s[1], s[2]);
+	mpz_swap(u[2], s[0]);
+	mpz_swap(u[3], s[1]);
+}
+
+// u = u*u, in place, 5 multiplications, as matrix_mpf_square.
+void fixed_matrix_square(fixed_context& ctx, mpz_t* u) {
+	mpz_t* s = ctx.scratch;
+	fixed_mul(ctx, s[0], u[1], u[2]);
+	mpz_add(s[1], u[0], u[3]);
+	fixed_sqr(ctx, s[2], u[0]);
+	mpz_add(u[0], s[2], s[0]);
+	fixed_sqr(ctx, s[2], u[3]);
+	mpz_add(u[3], s[2], s[0]);
+	fixed_mul(ctx, u[1], u[1], s[1]);
+	fixed_mul(ctx, u[2], u[2], s[1]);
+}
+
+
+/*------------------------------- Chebyshev Expensive & Economical Algorithm in Fixed Point -------------------------------*/
+
+
+void chebyshev_expensive_fixed_mpz(fixed_context& ctx, mpz_t result, const mpz_t x, const mpz_t s) {
+	mpz_t& t_prev = ctx.t[0];
+	mpz_t& t_curr = ctx.t[1];
+	mpz_t& t_next = ctx.t[2];
+	mpz_set_ui(t_prev, 1);
+	mpz_mul_2exp(t_prev, t_prev, ctx.frac_bits);
+	mpz_set(t_curr, x);
+	for (mpz_class i = 0; mpz_cmp(i.get_mpz_t(), s) < 0; i++) {
+		fixed_mul(ctx, t_next, x, t_curr);
+		mpz_mul_2exp(t_next, t_next, 1);
+		mpz_sub(t_next, t_next, t_prev);
+		mpz_swap(t_prev, t_curr);
+		mpz_swap(t_curr, t_next);
+	}
+	mpz_set(result, t_prev);
+}
+
+void chebyshev_economical_fixed_mpz(fixed_context& ctx, mpz_t result, const mpz_t x, const mpz_t n) {
+	// This algorithm does one more in default, so we need to substract one of the number of iterations.
+	mpz_class n_1(n);
+	n_1 -= 1;
+
+	fixed_matrix_set_mx(ctx, ctx.mx, x);
+	if (n_1 > 0) {
+		// from high to low order of 2
+		for (mp_bitcnt_t i = mpz_sizeinbase(n_1.get_mpz_t(), 2); i-- > 0; ) {
+			if (mpz_tstbit(n_1.get_mpz_t(), i)) {
+				fixed_matrix_set_mx(ctx, ctx.power, x);
+				// 2^k, matrix power from opposite direction.
+				for (mp_bitcnt_t j = 0; j < i; j++) {
+					fixed_matrix_square(ctx, ctx.power);
+				}
+				fixed_matrix_multiplication(ctx, ctx.mx, ctx.power);
+			}
+		}
+	}
+
+	// t*Mx, the first row of t is [T0(x), T1(x)], so Tn(x) = Mx0 + x*Mx2.
+	fixed_mul(ctx, result, x, ctx.mx[2]);
+	mpz_add(result, result, ctx.mx[0]);
+}
+
+void chebyshev_doubling_fixed_mpz(fixed_context& ctx, mpz_t result, const mpz_t x, const mpz_t n) {
+	mpz_t& t_k = ctx.t[0];	//Tk(x)
+	mpz_t& t_k1 = ctx.t[1];	//Tk+1(x)
+	mpz_t& t_odd = ctx.t[2];	//T2k+1(x)
+	mpz_t& one = ctx.scratch[0];
+	mpz_set_ui(one, 1);
+	mpz_mul_2exp(one, one, ctx.frac_bits);
+	mpz_set(t_k, one);	//T0(x)
+	mpz_set(t_k1, x);	//T1(x)
+
+	// Tn(x) = T-n(x), since Tn(cos(a)) = cos(na). A read-only view of |n| shares the limbs of n.
+	mpz_t abs_n;
+	mpz_roinit_n(abs_n, mpz_limbs_read(n), mpz_size(n));
+
+	for (mp_bitcnt_t i = mpz_sizeinbase(abs_n, 2); i-- > 0; ) {
+		// T2k+1(x) = 2Tk(x)Tk+1(x) - x, which is needed for both bits.
+		fixed_mul(ctx, t_odd, t_k, t_k1);
+		mpz_mul_2exp(t_odd, t_odd, 1);
+		mpz_sub(t_odd, t_odd, x);
+
+		if (mpz_tstbit(abs_n, i)) {
+			// (Tk, Tk+1) -> (T2k+1, T2k+2)
+			fixed_sqr(ctx, t_k1, t_k1);
+			mpz_mul_2exp(t_k1, t_k1, 1);
+			mpz_sub(t_k1, t_k1, one);
+			mpz_swap(t_k, t_odd);
+		}
+		else {
+			// (Tk, Tk+1) -> (T2k, T2k+1)
+			fixed_sqr(ctx, t_k, t_k);
+			mpz_mul_2exp(t_k, t_k, 1);
+			mpz_sub(t_k, t_k, one);
+			mpz_swap(t_k1, t_odd);
+		}
+	}
+	mpz_set(result, t_k);
+}
+
+// Convert x to fixed point, run the evaluation, and convert the result back at the precision F.
+mpf_class chebyshev_fixed_call(fixed_context& ctx, const mpf_class& x, const mpz_class& n,
+		void (*evaluation)(fixed_context&, mpz_t, const mpz_t, const mpz_t)) {
+	mpz_class x_fixed, result_fixed;
+	mpf_to_fixed(x_fixed.get_mpz_t(), x.get_mpf_t(), ctx.frac_bits);
+	evaluation(ctx, result_fixed.get_mpz_t(), x_fixed.get_mpz_t(), n.get_mpz_t());
+	mpf_class result(0, ctx.frac_bits + GMP_NUMB_BITS);
+	fixed_to_mpf(result.get_mpf_t(), result_fixed.get_mpz_t(), ctx.frac_bits);
+	return result;
+}
+
+mpf_class chebyshev_expensive_fixed(fixed_context& ctx, const mpf_class& x, const mpz_class& s) {
+	return chebyshev_fixed_call(ctx, x, s, chebyshev_expensive_fixed_mpz);
+}
+
+mpf_class chebyshev_economical_fixed(fixed_context& ctx, const mpf_class& x, const mpz_class& n) {
+	return chebyshev_fixed_call(ctx, x, n, chebyshev_economical_fixed_mpz);
+}
+
+mpf_class chebyshev_doubling_fixed(fixed_context& ctx, const mpf_class& x, const mpz_class& n) {
+	return chebyshev_fixed_call(ctx, x, n, chebyshev_doubling_fixed_mpz);
+}
+
+
+/*------------------------------- Fixed-Limb Fixed Point -------------------------------*/
+
+
+int fixed_prec_limbs(mp_bitcnt_t prec) {
+	if (prec <= 64*3) {
+		return 4;
+	}
+	if (prec <= 64*7) {
+		return 8;
+	}
+	if (prec <= 64*11) {
+		return 12;
+	}
+	if (prec <= 64*15) {
+		return 16;
+	}
+	return 0;
+}
+
+mpf_class chebyshev_ladder_dispatch(chebyshev_context& ctx, const mpf_class& x, const mpz_class& n) {
+	switch (fixed_prec_limbs(ctx.prec)) {
+	case 4:
+		return chebyshev_ladder_fixed_prec<4>(x, n);
+	case 8:
+		return chebyshev_ladder_fixed_prec<8>(x, n);
+	case 12:
+		return chebyshev_ladder_fixed_prec<12>(x, n);
+	case 16:
+		return chebyshev_ladder_fixed_prec<16>(x, n);
+	default:
+		return chebyshev_doubling(ctx, x, n);
+	}
+}
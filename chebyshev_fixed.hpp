@@ -0,0 +1,304 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This Program is the Fixed-Point Part of the Library of our Chebyshev Article.
+// For |x| <= 1 every Tn(x) stays in [-1, 1], so we do not need the exponent of mpf: a number is an mpz v
+// standing for v / 2^F, where F is the number of fractional bits, and every product is truncated back to F bits.
+//
+// Error bound, with u = 2^-F and x the fixed-point input (exactly v / 2^F), for |x| <= 1:
+// - expensive: every step Tk+1 = 2x*Tk - Tk-1 adds an error of at most 2u, and an error d at step k becomes
+//   U(n-k-1)(x)*d at step n, where |Uj(x)| <= j+1. So |result - Tn(x)| <= n(n+1)u.
+// - doubling: every bit of n turns the error E of (Tk, Tk+1) into at most 4E + 2u, so after the L = log2(n) + 1
+//   bits of n, |result - Tn(x)| <= 2u(4^L - 1)/3 < (8/3)n^2 u (to the first order, while n^2 u is small).
+// - economical: the entries of Mx^k are Chebyshev polynomials of the second kind, bounded by k+1, and the error
+//   is of the same order n^2 u, which chebyshev_fixed_benchmark measures against mpf at a much higher precision.
+// The products are truncated to -infinity (mpz_fdiv_q_2exp), so the error is one-sided for every single product.
+#ifndef CHEBYSHEV_FIXED_HPP
+#define CHEBYSHEV_FIXED_HPP
+
+#include <iostream>
+#include <string>
+#include <stdint.h>
+
+#include <gmpxx.h>
+#include "chebyshev.hpp"
+
+using namespace std;
+
+
+/*------------------------------- Fixed-Point Numbers -------------------------------*/
+
+
+// The temporaries of the fixed-point evaluations with frac_bits fractional bits.
+// The mpz are allocated once for 2*frac_bits + 2 bits (a product), so an evaluation does not reallocate.
+struct fixed_context {
+	mp_bitcnt_t frac_bits;
+	mpz_t t[3];
+	mpz_t product;
+	mpz_t mx[4];
+	mpz_t power[4];
+	mpz_t scratch[3];
+
+	fixed_context(mp_bitcnt_t frac_bits);
+	~fixed_context();
+	fixed_context(const fixed_context&) = delete;
+	fixed_context& operator=(const fixed_context&) = delete;
+};
+
+// v = floor(x * 2^frac_bits)
+void mpf_to_fixed(mpz_t v, const mpf_t x, mp_bitcnt_t frac_bits);
+
+// x = v / 2^frac_bits, exact if x has at least the bits of v.
+void fixed_to_mpf(mpf_t x, const mpz_t v, mp_bitcnt_t frac_bits);
+
+// r = floor(a*b / 2^F), r may be a or b.
+void fixed_mul(fixed_context& ctx, mpz_t r, const mpz_t a, const mpz_t b);
+
+// r = floor(a^2 / 2^F), r may be a.
+void fixed_sqr(fixed_context& ctx, mpz_t r, const mpz_t a);
+
+
+/*------------------------------- Chebyshev Expensive & Economical Algorithm in Fixed Point -------------------------------*/
+
+
+// result = Ts(x) by Tk+1 = 2x*Tk - Tk-1, s steps, as chebyshev_expensive.
+void chebyshev_expensive_fixed_mpz(fixed_context& ctx, mpz_t result, const mpz_t x, const mpz_t s);
+
+// result = Tn(x) by the powers Mx^(2^k) of the bits of n - 1, as chebyshev_economical.
+void chebyshev_economical_fixed_mpz(fixed_context& ctx, mpz_t result, const mpz_t x, const mpz_t n);
+
+// result = Tn(x) by T2k = 2Tk^2 - 1 and T2k+1 = 2TkTk+1 - x, as chebyshev_doubling.
+void chebyshev_doubling_fixed_mpz(fixed_context& ctx, mpz_t result, const mpz_t x, const mpz_t n);
+
+// The same with mpf_class input and output: x is truncated to F bits, and the result has the precision F.
+mpf_class chebyshev_expensive_fixed(fixed_context& ctx, const mpf_class& x, const mpz_class& s);
+
+mpf_class chebyshev_economical_fixed(fixed_context& ctx, const mpf_class& x, const mpz_class& n);
+
+mpf_class chebyshev_doubling_fixed(fixed_context& ctx, const mpf_class& x, const mpz_class& n);
+
+
+/*------------------------------- Fixed-Limb Fixed Point -------------------------------*/
+
+
+// A number of N 64-bit limbs in two's complement, least significant first: the top limb is the integer part,
+// and the N-1 other limbs are the F = 64(N-1) fractional bits. fixed_prec<4>, <8>, <12> and <16> have 192, 448, 704
+// and 960 fractional bits, which covers m up to 60, 140, 220 and 300 digits.
+// Everything is on the stack and every loop has the constant bound N, so the kernels are unrolled and inlined
+// at -O2 without any call to GMP. A product is truncated with an error less than (N-1)2^-F, so the error bound
+// is the one of the doubling method above with u = (N-1)2^-F.
+template <int N>
+struct fixed_prec {
+	uint64_t limb[N];
+};
+
+template <int N>
+inline bool fixed_prec_is_negative(const fixed_prec<N>& a) {
+	return a.limb[N-1] >> 63;
+}
+
+// a = -a
+template <int N>
+inline void fixed_prec_negate(fixed_prec<N>& a) {
+	unsigned __int128 carry = 1;
+	for (int i = 0; i < N; i++) {
+		carry += uint64_t(~a.limb[i]);
+		a.limb[i] = uint64_t(carry);
+		carry >>= 64;
+	}
+}
+
+// r = a + b
+template <int N>
+inline void fixed_prec_add(fixed_prec<N>& r, const fixed_prec<N>& a, const fixed_prec<N>& b) {
+	unsigned __int128 carry = 0;
+	for (int i = 0; i < N; i++) {
+		carry += (unsigned __int128)a.limb[i] + b.limb[i];
+		r.limb[i] = uint64_t(carry);
+		carry >>= 64;
+	}
+}
+
+// r = a - b = a + ~b + 1
+template <int N>
+inline void fixed_prec_sub(fixed_prec<N>& r, const fixed_prec<N>& a, const fixed_prec<N>& b) {
+	unsigned __int128 carry = 1;
+	for (int i = 0; i < N; i++) {
+		carry += (unsigned __int128)a.limb[i] + uint64_t(~b.limb[i]);
+		r.limb[i] = uint64_t(carry);
+		carry >>= 64;
+	}
+}
+
+// The 192-bit accumulator (c0, c1, c2) of a column of products.
+struct fixed_prec_column {
+	uint64_t c0, c1, c2;
+};
+
+// Add a 128-bit product p of two limbs to the accumulator. The high limb of p is at most 2^64 - 2, so it takes the carry of c0.
+inline void fixed_prec_accumulate(fixed_prec_column& acc, unsigned __int128 p) {
+	uint64_t low = uint64_t(p);
+	uint64_t high = uint64_t(p >> 64);
+	acc.c0 += low;
+	high += (acc.c0 < low);
+	acc.c1 += high;
+	acc.c2 += (acc.c1 < high);
+}
+
+// Give the low limb of the accumulator to the column, and shift the accumulator for the next column.
+inline uint64_t fixed_prec_next_column(fixed_prec_column& acc) {
+	uint64_t column = acc.c0;
+	acc.c0 = acc.c1;
+	acc.c1 = acc.c2;
+	acc.c2 = 0;
+	return column;
+}
+
+// r = a*b / 2^F on the magnitudes, column by column (Comba): the column k of the product is the sum of ai*bj
+// with i + j = k, and only the columns N-2 to 2N-2 are computed, since r is the columns N-1 to 2N-2.
+// The columns below N-2 would change r by less than N-2 units of 2^-F, so with the truncation
+// the error of a product is less than (N-1)2^-F.
+template <int N>
+inline void fixed_prec_mul(fixed_prec<N>& r, const fixed_prec<N>& a, const fixed_prec<N>& b) {
+	fixed_prec<N> ma = a, mb = b;
+	bool negative = fixed_prec_is_negative(a) != fixed_prec_is_negative(b);
+	if (fixed_prec_is_negative(ma)) {
+		fixed_prec_negate(ma);
+	}
+	if (fixed_prec_is_negative(mb)) {
+		fixed_prec_negate(mb);
+	}
+	fixed_prec_column acc = {0, 0, 0};
+	#pragma GCC unroll 32
+	for (int k = N-2; k <= 2*N-2; k++) {
+		// Constant bounds, so the unrolled loop keeps only the i with 0 <= k-i < N.
+		#pragma GCC unroll 16
+		for (int i = 0; i < N; i++) {
+			if (k-i >= 0 && k-i < N) {
+				fixed_prec_accumulate(acc, (unsigned __int128)ma.limb[i] * mb.limb[k-i]);
+			}
+		}
+		uint64_t column = fixed_prec_next_column(acc);
+		if (k >= N-1) {
+			r.limb[k-N+1] = column;
+		}
+	}
+	if (negative) {
+		fixed_prec_negate(r);
+	}
+}
+
+// r = a^2 / 2^F, as fixed_prec_mul, with the products ai*aj (i < j) of a column computed once and added twice.
+template <int N>
+inline void fixed_prec_sqr(fixed_prec<N>& r, const fixed_prec<N>& a) {
+	fixed_prec<N> ma = a;
+	if (fixed_prec_is_negative(ma)) {
+		fixed_prec_negate(ma);
+	}
+	fixed_prec_column acc = {0, 0, 0};
+	#pragma GCC unroll 32
+	for (int k = N-2; k <= 2*N-2; k++) {
+		#pragma GCC unroll 16
+		for (int i = 0; i < N; i++) {
+			if (i < k-i && k-i < N) {
+				unsigned __int128 p = (unsigned __int128)ma.limb[i] * ma.limb[k-i];
+				fixed_prec_accumulate(acc, p);
+				fixed_prec_accumulate(acc, p);
+			}
+		}
+		if (k % 2 == 0) {
+			fixed_prec_accumulate(acc, (unsigned __int128)ma.limb[k/2] * ma.limb[k/2]);
+		}
+		uint64_t column = fixed_prec_next_column(acc);
+		if (k >= N-1) {
+			r.limb[k-N+1] = column;
+		}
+	}
+}
+
+// r = floor(x * 2^F), x in (-2^63, 2^63).
+template <int N>
+void mpf_to_fixed_prec(fixed_prec<N>& r, const mpf_t x) {
+	static_assert(GMP_NUMB_BITS == 64, "fixed_prec needs 64-bit limbs");
+	mpz_class v;
+	mpf_to_fixed(v.get_mpz_t(), x, 64*(N-1));
+	bool negative = (v < 0);
+	v = abs(v);
+	for (int i = 0; i < N; i++) {
+		r.limb[i] = mpz_getlimbn(v.get_mpz_t(), i);
+	}
+	if (negative) {
+		fixed_prec_negate(r);
+	}
+}
+
+// x = a, exact if x has at least 64N bits.
+template <int N>
+void fixed_prec_to_mpf(mpf_t x, const fixed_prec<N>& a) {
+	fixed_prec<N> m = a;
+	bool negative = fixed_prec_is_negative(a);
+	if (negative) {
+		fixed_prec_negate(m);
+	}
+	mpz_class v;
+	mpz_import(v.get_mpz_t(), N, -1, 8, 0, 0, m.limb);
+	if (negative) {
+		v = -v;
+	}
+	fixed_to_mpf(x, v.get_mpz_t(), 64*(N-1));
+}
+
+// result = Tn(x) by the (Tk, Tk+1) ladder of chebyshev_doubling: 1 multiplication and 1 squaring per bit of n.
+template <int N>
+void fixed_prec_ladder(fixed_prec<N>& result, const fixed_prec<N>& x, const mpz_t n) {
+	fixed_prec<N> one = {}, t_k, t_k1, t_odd;
+	one.limb[N-1] = 1;
+	t_k = one;	//T0(x)
+	t_k1 = x;	//T1(x)
+
+	// Tn(x) = T-n(x), so we scan the bits of |n|.
+	mpz_t abs_n;
+	mpz_roinit_n(abs_n, mpz_limbs_read(n), mpz_size(n));
+	for (mp_bitcnt_t i = mpz_sizeinbase(abs_n, 2); i-- > 0; ) {
+		// T2k+1(x) = 2Tk(x)Tk+1(x) - x, which is needed for both bits.
+		fixed_prec_mul(t_odd, t_k, t_k1);
+		fixed_prec_add(t_odd, t_odd, t_odd);
+		fixed_prec_sub(t_odd, t_odd, x);
+
+		if (mpz_tstbit(abs_n, i)) {
+			// (Tk, Tk+1) -> (T2k+1, T2k+2)
+			fixed_prec_sqr(t_k1, t_k1);
+			fixed_prec_add(t_k1, t_k1, t_k1);
+			fixed_prec_sub(t_k1, t_k1, one);
+			t_k = t_odd;
+		}
+		else {
+			// (Tk, Tk+1) -> (T2k, T2k+1)
+			fixed_prec_sqr(t_k, t_k);
+			fixed_prec_add(t_k, t_k, t_k);
+			fixed_prec_sub(t_k, t_k, one);
+			t_k1 = t_odd;
+		}
+	}
+	result = t_k;
+}
+
+// Tn(x) on fixed_prec<N>, with mpf_class input and output (precision 64N).
+template <int N>
+mpf_class chebyshev_ladder_fixed_prec(const mpf_class& x, const mpz_class& n) {
+	fixed_prec<N> x_fixed, result_fixed;
+	mpf_to_fixed_prec(x_fixed, x.get_mpf_t());
+	fixed_prec_ladder(result_fixed, x_fixed, n.get_mpz_t());
+	mpf_class result(0, 64*N);
+	fixed_prec_to_mpf(result.get_mpf_t(), result_fixed);
+	return result;
+}
+
+// The limbs N of the smallest fixed_prec<4>, <8>, <12> or <16> with at least prec fractional bits, or 0 above 960 bits.
+int fixed_prec_limbs(mp_bitcnt_t prec);
+
+// Tn(x) with at least ctx.prec bits: on fixed_prec<fixed_prec_limbs(ctx.prec)>, or by chebyshev_doubling with ctx
+// on GMP above 960 bits.
+mpf_class chebyshev_ladder_dispatch(chebyshev_context& ctx, const mpf_class& x, const mpz_class& n);
+
+#endif
@@ -0,0 +1,144 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This program compares the fixed-point engine (chebyshev_fixed.hpp) with the mpf engine at the same number of bits,
+// for m = 120, 1000 and 10000 digits. For each m it measures the evaluations per second of the expensive method
+// (10^4 steps), of the economical method and of the doubling method (s = 10^length), and the error of the fixed-point
+// results against Ts(x) computed by mpf with twice the precision, next to the bound of chebyshev_fixed.hpp.
+// The errors are printed as powers of 2, since at m = 10000 they are far below the smallest double.
+
+// In order to compile and run this program, you need to install two libraries: GMP and MPFR.
+// Compile: g++ -o chebyshev_fixed_benchmark chebyshev_fixed_benchmark.cpp chebyshev.cpp chebyshev_fixed.cpp -lmpfr -lgmpxx -lgmp
+// Run: ./chebyshev_fixed_benchmark <length of s> (s = 10^length, less than 120)
+#include <iostream>
+#include <string>
+
+#include <gmpxx.h>
+#include <mpreal.h>
+#include "chebyshev.hpp"
+#include "chebyshev_fixed.hpp"
+
+#include <time.h>
+
+using namespace std;
+
+// log2 of |a|, or a very negative number for 0.
+long log2_mpf(const mpf_class& a) {
+	if (a == 0) {
+		return -1000000;
+	}
+	long power;
+	mpf_get_d_2exp(&power, a.get_mpf_t());
+	return power;
+}
+
+int main (int argc, char* argv[]) {
+	int n_s;
+	if (argc == 2) {
+		n_s = atoi(argv[1]);
+	}
+	else {
+		cout << "Notice: If you want to run this program, you need 1 input, such that: " << endl;
+		cout << "Example: ./chebyshev_fixed_benchmark <length of s> (s = 10^length, less than 120) " << endl;
+		cout << "For example: ./chebyshev_fixed_benchmark 8" << endl;
+		return 0;
+	}
+
+	mpz_class s;
+	mpz_ui_pow_ui(s.get_mpz_t(), 10, n_s);
+	mpz_class s_expensive = 10000;
+	cout << "s = 10^" << n_s << ", expensive method with s = " << s_expensive << endl;
+
+	int n_precisions = 3;
+	int precisions[] = {120, 1000, 10000};
+	clock_t start, end;
+	cout.precision(6);
+
+	for (int p = 0; p < n_precisions; p++) {
+		int n_digits_m = precisions[p];
+		mp_bitcnt_t prec = digits2bit_mpf(n_digits_m);
+		chebyshev_context ctx(prec);
+		fixed_context fixed(prec);
+
+		// Choose x as 0.111... with precision m number of digits, truncated to the fixed point,
+		// such that both engines start from the same x.
+		string x_string = "1";
+		while (x_string.length() < n_digits_m)
+			x_string += "1";
+		mpf_class x = context_mpf(ctx, "0." + x_string);
+		mpz_class x_fixed;
+		mpf_to_fixed(x_fixed.get_mpz_t(), x.get_mpf_t(), prec);
+		fixed_to_mpf(x.get_mpf_t(), x_fixed.get_mpz_t(), prec);
+
+		// Reference values with twice the precision.
+		chebyshev_context reference(2*prec + 64);
+		mpf_class x_reference(x, 2*prec + 64);
+		mpf_class reference_s = chebyshev_doubling(reference, x_reference, s);
+		mpf_class reference_expensive = chebyshev_doubling(reference, x_reference, s_expensive);
+
+		// Fewer repetitions for the larger precisions.
+		int repetitions = (n_digits_m <= 120) ? 2000 : (n_digits_m <= 1000 ? 200 : 10);
+		int repetitions_expensive = (n_digits_m <= 1000) ? 5 : 1;
+		mpf_class y, y_fixed;
+		double times[6];
+
+		start = clock();
+		for (int i = 0; i < repetitions_expensive; i++) {
+			y = chebyshev_expensive(ctx, x, s_expensive);
+		}
+		end = clock();
+		times[0] = double(end - start)/CLOCKS_PER_SEC/repetitions_expensive;
+		start = clock();
+		for (int i = 0; i < repetitions_expensive; i++) {
+			y_fixed = chebyshev_expensive_fixed(fixed, x, s_expensive);
+		}
+		end = clock();
+		times[1] = double(end - start)/CLOCKS_PER_SEC/repetitions_expensive;
+		mpf_class error_expensive = abs(y_fixed - reference_expensive);
+
+		start = clock();
+		for (int i = 0; i < repetitions; i++) {
+			y = chebyshev_economical(ctx, x, s);
+		}
+		end = clock();
+		times[2] = double(end - start)/CLOCKS_PER_SEC/repetitions;
+		start = clock();
+		for (int i = 0; i < repetitions; i++) {
+			y_fixed = chebyshev_economical_fixed(fixed, x, s);
+		}
+		end = clock();
+		times[3] = double(end - start)/CLOCKS_PER_SEC/repetitions;
+		mpf_class error_economical = abs(y_fixed - reference_s);
+
+		start = clock();
+		for (int i = 0; i < repetitions; i++) {
+			y = chebyshev_doubling(ctx, x, s);
+		}
+		end = clock();
+		times[4] = double(end - start)/CLOCKS_PER_SEC/repetitions;
+		start = clock();
+		for (int i = 0; i < repetitions; i++) {
+			y_fixed = chebyshev_doubling_fixed(fixed, x, s);
+		}
+		end = clock();
+		times[5] = double(end - start)/CLOCKS_PER_SEC/repetitions;
+		mpf_class error_doubling = abs(y_fixed - reference_s);
+
+		// The bounds n(n+1)2^-F and (8/3)n^2 2^-F, as powers of 2.
+		mpf_class n_expensive(s_expensive, 64), n_s_mpf(s, 64 + 4*n_s);
+		long bound_expensive = log2_mpf(n_expensive * (n_expensive + 1)) - long(prec);
+		long bound_doubling = log2_mpf(n_s_mpf * n_s_mpf * 8 / 3) - long(prec);
+
+		cout << endl << "m = " << n_digits_m << " digits, F = " << prec << " bits" << endl;
+		cout << "method, mpf evaluations/s, fixed evaluations/s, speedup, fixed error, bound" << endl;
+		string names[] = {"expensive", "economical", "doubling"};
+		long errors[] = {log2_mpf(error_expensive), log2_mpf(error_economical), log2_mpf(error_doubling)};
+		long bounds[] = {bound_expensive, bound_doubling, bound_doubling};
+		for (int j = 0; j < 3; j++) {
+			cout << names[j] << ", " << 1 / times[2*j] << ", " << 1 / times[2*j + 1] << ", " << times[2*j] / times[2*j + 1] << ", ";
+			cout << "2^" << errors[j] << ", 2^" << bounds[j] << endl;
+		}
+	}
+
+	return 0;
+}
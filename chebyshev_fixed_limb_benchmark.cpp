@@ -0,0 +1,91 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This program measures the fixed-limb templates fixed_prec<4>, <8>, <12> and <16> of chebyshev_fixed.hpp against GMP,
+// for m from 30 to 400 digits. For every m, chebyshev_ladder_dispatch chooses the smallest fixed_prec with at least
+// digits2bit_mpf(m) fractional bits, or GMP above 960 bits, and we compare its evaluations per second of Ts(x)
+// with chebyshev_doubling (mpf) and chebyshev_doubling_fixed (mpz), which do the same iteration, and print the
+// difference of the results.
+// The templates need the optimization of the compiler to be unrolled and inlined, so this program is compiled with -O2.
+
+// In order to compile and run this program, you need to install two libraries: GMP and MPFR.
+// Compile: g++ -O2 -o chebyshev_fixed_limb_benchmark chebyshev_fixed_limb_benchmark.cpp chebyshev.cpp chebyshev_fixed.cpp -lmpfr -lgmpxx -lgmp
+// Run: ./chebyshev_fixed_limb_benchmark <length of secret key> (s = 10^length)
+#include <iostream>
+#include <string>
+
+#include <gmpxx.h>
+#include <mpreal.h>
+#include "chebyshev.hpp"
+#include "chebyshev_fixed.hpp"
+
+#include <time.h>
+
+using namespace std;
+
+int main (int argc, char* argv[]) {
+	int n_s;
+	if (argc == 2) {
+		n_s = atoi(argv[1]);
+	}
+	else {
+		cout << "Notice: If you want to run this program, you need 1 input, such that: " << endl;
+		cout << "Example: ./chebyshev_fixed_limb_benchmark <length of secret key> (s = 10^length) " << endl;
+		cout << "For example: ./chebyshev_fixed_limb_benchmark 8" << endl;
+		return 0;
+	}
+
+	mpz_class s;
+	mpz_ui_pow_ui(s.get_mpz_t(), 10, n_s);
+	cout << "s = 10^" << n_s << endl;
+
+	int n_precisions = 7;
+	int precisions[] = {30, 60, 100, 120, 200, 300, 400};
+	int repetitions = 20000;
+	clock_t start, end;
+	cout.precision(6);
+	cout << endl << "m, bits, engine, mpf evaluations/s, mpz evaluations/s, fixed_prec evaluations/s, speedup against mpf, difference" << endl;
+
+	for (int p = 0; p < n_precisions; p++) {
+		int n_digits_m = precisions[p];
+		mp_bitcnt_t prec = digits2bit_mpf(n_digits_m);
+		chebyshev_context ctx(prec);
+		fixed_context fixed(prec);
+
+		// Choose x as 0.111... with precision m number of digits.
+		string x_string = "1";
+		while (x_string.length() < n_digits_m)
+			x_string += "1";
+		mpf_class x = context_mpf(ctx, "0." + x_string);
+
+		mpf_class y_mpf, y_mpz, y_limb;
+		start = clock();
+		for (int i = 0; i < repetitions; i++) {
+			y_mpf = chebyshev_doubling(ctx, x, s);
+		}
+		end = clock();
+		double time_mpf = double(end - start)/CLOCKS_PER_SEC/repetitions;
+
+		start = clock();
+		for (int i = 0; i < repetitions; i++) {
+			y_mpz = chebyshev_doubling_fixed(fixed, x, s);
+		}
+		end = clock();
+		double time_mpz = double(end - start)/CLOCKS_PER_SEC/repetitions;
+
+		start = clock();
+		for (int i = 0; i < repetitions; i++) {
+			y_limb = chebyshev_ladder_dispatch(ctx, x, s);
+		}
+		end = clock();
+		double time_limb = double(end - start)/CLOCKS_PER_SEC/repetitions;
+
+		int limbs = fixed_prec_limbs(prec);
+		string engine = (limbs == 0) ? "GMP" : "fixed_prec<" + to_string(limbs) + ">";
+		mpf_class difference = y_limb - y_mpf;
+		cout << n_digits_m << ", " << prec << ", " << engine << ", " << 1 / time_mpf << ", " << 1 / time_mpz << ", " << 1 / time_limb << ", ";
+		cout << time_mpf / time_limb << ", " << difference.get_d() << endl;
+	}
+
+	return 0;
+}
@@ -3,16 +3,18 @@
 
 // This program aims test the relationship between l, m, and s as we mentioned in the paper.
 // Namely, for fixed precision l, and m, we want to know how large s and r (r=s-1) is that can be supported to succeed in decryption. 
+// With a calibration file, every length of s we try is also added to its records (chebyshev_calibration.hpp).
 
 // In order to compile and run this program, you need to install two libraries: GMP and MPFR.
-// Compile: g++ -o chebyshev_gmp_relation chebyshev_gmp_relation.cpp chebyshev.cpp -lmpfr -lgmpxx -lgmp
-// Run: ./chebyshev_gmp_relation <precision l> <precision m> (l for assignment, m for compuation)
+// Compile: g++ -o chebyshev_gmp_relation chebyshev_gmp_relation.cpp chebyshev.cpp chebyshev_calibration.cpp -lmpfr -lgmpxx -lgmp
+// Run: ./chebyshev_gmp_relation <precision l> <precision m> [calibration file] (l for assignment, m for compuation)
 #include <iostream>
 #include <string>
 
 #include <gmpxx.h>
 #include <mpreal.h>
 #include "chebyshev.hpp"
+#include "chebyshev_calibration.hpp"
 
 #include <time.h>
 
@@ -20,13 +22,15 @@ using namespace std;
 
 int main (int argc, char* argv[]) {
 	int n_digits_l, n_digits_m;
-	if (argc == 3) {
+	string calibration_path;
+	if (argc == 3 || argc == 4) {
 		n_digits_l = atoi(argv[1]);
 		n_digits_m = atoi(argv[2]);		
+		calibration_path = (argc == 4) ? argv[3] : "";
 	}
 	else {
 		cout << "Notice: If you want to run this program, you need 2 inputs, such that: " << endl;
-		cout << "Example: ./chebyshev_gmp_relation <precision l> <precision m> (l for assignment, m for compuation) " << endl;
+		cout << "Example: ./chebyshev_gmp_relation <precision l> <precision m> [calibration file] (l for assignment, m for compuation) " << endl;
 		cout << "For example: ./chebyshev_gmp_relation 100 120" << endl;
 		return 0;
 	}
@@ -101,6 +105,11 @@ int main (int argc, char* argv[]) {
 	end = clock();
 
 	mpz_class length = 1;
+	calibration_table calibration;
+	if (!calibration_path.empty() && !load_calibration(calibration_path, calibration)) {
+		cout << calibration_path << " is not a calibration file!" << endl;
+		return 1;
+	}
 
 	int max_iterations = 100;
 	for (int i = 0; i < max_iterations; i++) {
@@ -111,6 +120,7 @@ int main (int argc, char* argv[]) {
 		cout << "u_recover = " << u_recover << endl;
 		cout << "Difference = " << u - u_recover << endl;
 		cout << "Time = " << double(end - start)/CLOCKS_PER_SEC << "s" << endl << endl;
+		calibration_add(calibration, n_digits_l, n_digits_m, length.get_si(), abs(u - u_recover) < error);
 
 		if (abs(u - u_recover) < error) {
 			start = clock();
@@ -138,6 +148,10 @@ int main (int argc, char* argv[]) {
 			break;
 		}
 	}
+	if (!calibration_path.empty() && !save_calibration(calibration_path, calibration)) {
+		cout << "Cannot write " << calibration_path << endl;
+		return 1;
+	}
 	
 	return 0;
 }
@@ -3,16 +3,18 @@
 
 // After we get the largest s that is supported by l and m, we want to do 20 iterations and store the 
 // statistically average values of number of operations, error, and time cost. The table in the paper is constructed using this program.
+// With a calibration file, the result (success if the average difference is below the error) is added to its records.
 
 // In order to compile and run this program, you need to install two libraries: GMP and MPFR.
-// Compile: g++ -o chebyshev_gmp_relation_average chebyshev_gmp_relation_average.cpp chebyshev.cpp -lmpfr -lgmpxx -lgmp
-// Run: ./chebyshev_gmp_relation_average <precision l> <precision m> <length of secret key> (l for assignment, m for compuation)
+// Compile: g++ -o chebyshev_gmp_relation_average chebyshev_gmp_relation_average.cpp chebyshev.cpp chebyshev_calibration.cpp -lmpfr -lgmpxx -lgmp
+// Run: ./chebyshev_gmp_relation_average <precision l> <precision m> <length of secret key> [calibration file] (l for assignment, m for compuation)
 #include <iostream>
 #include <string>
 
 #include <gmpxx.h>
 #include <mpreal.h>
 #include "chebyshev.hpp"
+#include "chebyshev_calibration.hpp"
 
 #include <time.h>
 
@@ -20,14 +22,16 @@ using namespace std;
 
 int main (int argc, char* argv[]) {
 	int n_digits_l, n_digits_m, n_s;
-	if (argc == 4) {
+	string calibration_path;
+	if (argc == 4 || argc == 5) {
 		n_digits_l = atoi(argv[1]);
 		n_digits_m = atoi(argv[2]);		
 		n_s = atoi(argv[3]);
+		calibration_path = (argc == 5) ? argv[4] : "";
 	}
 	else {
 		cout << "Notice: If you want to run this program, you need 2 inputs, such that: " << endl;
-		cout << "Example: ./chebyshev_gmp_relation_average <precision l> <precision m> <length of secret key> (l for assignment, m for compuation, s = 10^length) " << endl;
+		cout << "Example: ./chebyshev_gmp_relation_average <precision l> <precision m> <length of secret key> [calibration file] (l for assignment, m for compuation, s = 10^length) " << endl;
 		cout << "For example: ./chebyshev_gmp_relation_average 100 120 8" << endl;
 		return 0;
 	}
@@ -156,6 +160,19 @@ int main (int argc, char* argv[]) {
 		cout << "The average difference is greater than the error, means the decryption failed!" << endl;
 	}
 
+	if (!calibration_path.empty()) {
+		calibration_table calibration;
+		if (!load_calibration(calibration_path, calibration)) {
+			cout << calibration_path << " is not a calibration file!" << endl;
+			return 1;
+		}
+		calibration_add(calibration, n_digits_l, n_digits_m, n_s, difference_count/n_iterations_mpf < error);
+		if (!save_calibration(calibration_path, calibration)) {
+			cout << "Cannot write " << calibration_path << endl;
+			return 1;
+		}
+	}
+
 	return 0;
 }
 
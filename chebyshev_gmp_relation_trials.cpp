@@ -0,0 +1,99 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This program is the parallel version of chebyshev_gmp_relation_average: it runs <trials> trials of l, m and s = 10^length
+// on <threads> threads with relation_trials of chebyshev_parallel.hpp, where every trial draws its r from its own random
+// stream seeded by (<seed>, trial), so the same seed gives the same r whatever the number of threads.
+// Every phase (keygen y = Ts(x), z0 = Tr(x), z1 = Tr(y), decryption) is timed in wall-clock time, not in CPU time as clock(),
+// and the program prints min, median, p90, p99, max and mean of every phase and of the whole trial, with the number
+// of trials that recovered u and the trials per second of the whole run, in CSV (one row per phase) or in JSON.
+
+// In order to compile and run this program, you need to install two libraries: GMP and MPFR.
+// Compile: g++ -o chebyshev_gmp_relation_trials chebyshev_gmp_relation_trials.cpp chebyshev.cpp chebyshev_parallel.cpp -lmpfr -lgmpxx -lgmp -pthread
+// Run: ./chebyshev_gmp_relation_trials <precision l> <precision m> <length of secret key> <trials> <seed> <threads> <csv|json>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include <gmpxx.h>
+#include <mpreal.h>
+#include "chebyshev.hpp"
+#include "chebyshev_parallel.hpp"
+
+using namespace std;
+
+int main (int argc, char* argv[]) {
+	int n_digits_l = 0, n_digits_m = 0, n_s = 0, trials_n = 0, threads_n = -1;
+	mpz_class seed;
+	string format;
+	bool seed_valid = false;
+	if (argc == 8) {
+		n_digits_l = atoi(argv[1]);
+		n_digits_m = atoi(argv[2]);
+		n_s = atoi(argv[3]);
+		trials_n = atoi(argv[4]);
+		seed_valid = (seed.set_str(argv[5], 10) == 0);
+		threads_n = atoi(argv[6]);
+		format = argv[7];
+	}
+	if (argc != 8 || !seed_valid || n_digits_l < 2 || n_digits_m <= 0 || n_s <= 0 || trials_n <= 0 || threads_n < 0
+			|| (format != "csv" && format != "json")) {
+		cout << "Notice: If you want to run this program, you need 7 inputs, such that: " << endl;
+		cout << "Example: ./chebyshev_gmp_relation_trials <precision l> <precision m> <length of secret key> <trials> <seed> <threads> <csv|json> ";
+		cout << "(threads 0 for all the cores) " << endl;
+		cout << "For example: ./chebyshev_gmp_relation_trials 100 120 8 200 2026 0 json" << endl;
+		return 0;
+	}
+	if (threads_n == 0) {
+		threads_n = hardware_threads();
+	}
+
+	thread_pool pool(threads_n);
+	relation_trial* trials = new relation_trial[trials_n];
+	auto start = chrono::steady_clock::now();
+	relation_trials(pool, n_digits_l, n_digits_m, n_s, seed, trials_n, trials);
+	double wall = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	int successes = 0;
+	vector<double> phases[TRIAL_PHASES + 1];
+	for (int i = 0; i < trials_n; i++) {
+		double total = 0;
+		for (int k = 0; k < TRIAL_PHASES; k++) {
+			phases[k].push_back(trials[i].seconds[k]);
+			total += trials[i].seconds[k];
+		}
+		phases[TRIAL_PHASES].push_back(total);
+		successes += trials[i].success;
+	}
+	delete[] trials;
+
+	cout.precision(6);
+	if (format == "csv") {
+		cout << "l,m,key_length,threads,trials,successes,wall_seconds,trials_per_second,phase,min,median,p90,p99,max,mean" << endl;
+	}
+	else {
+		cout << "{\"l\": " << n_digits_l << ", \"m\": " << n_digits_m << ", \"key_length\": " << n_s << ", \"threads\": " << threads_n;
+		cout << ", \"trials\": " << trials_n << ", \"seed\": \"" << seed << "\", \"successes\": " << successes;
+		cout << ", \"wall_seconds\": " << wall << ", \"trials_per_second\": " << trials_n / wall << ", \"phases\": {";
+	}
+	for (int k = 0; k <= TRIAL_PHASES; k++) {
+		string name = (k < TRIAL_PHASES) ? trial_phase_names[k] : "total";
+		latency_summary summary = summarize_latencies(phases[k]);
+		if (format == "csv") {
+			cout << n_digits_l << "," << n_digits_m << "," << n_s << "," << threads_n << "," << trials_n << "," << successes << ",";
+			cout << wall << "," << trials_n / wall << "," << name << "," << summary.min << "," << summary.median << ",";
+			cout << summary.p90 << "," << summary.p99 << "," << summary.max << "," << summary.mean << endl;
+		}
+		else {
+			cout << (k == 0 ? "" : ", ") << "\"" << name << "\": {\"min\": " << summary.min << ", \"median\": " << summary.median;
+			cout << ", \"p90\": " << summary.p90 << ", \"p99\": " << summary.p99 << ", \"max\": " << summary.max;
+			cout << ", \"mean\": " << summary.mean << "}";
+		}
+	}
+	if (format == "json") {
+		cout << "}}" << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,351 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This Program is the Limb-Interleaved Part of the Library of our Chebyshev Article:
+// Tn(x) on batches of fixed-point numbers stored limb by limb. See chebyshev_interleaved.hpp.
+#include <iostream>
+#include <string>
+#include <cstdint>
+
+#include <gmpxx.h>
+#include "chebyshev.hpp"
+#include "chebyshev_fixed.hpp"
+#include "chebyshev_interleaved.hpp"
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+
+/*------------------------------- Limb-Interleaved Batches -------------------------------*/
+
+
+interleaved_batch::interleaved_batch(int count, mp_bitcnt_t prec, int limb_bits) : count(count), limb_bits(limb_bits) {
+	stride = (count + INTERLEAVED_MAX_LANES - 1) / INTERLEAVED_MAX_LANES * INTERLEAVED_MAX_LANES;
+	// The fractional limbs, and the integer limb.
+	mp_bitcnt_t limbs_needed = (prec + limb_bits - 1) / limb_bits + 1;
+	limbs = limbs_needed < INTERLEAVED_MAX_LIMBS ? int(limbs_needed) : INTERLEAVED_MAX_LIMBS;
+	frac_bits = mp_bitcnt_t(limb_bits) * (limbs - 1);
+	data = new uint64_t[size_t(limbs) * stride]();
+}
+
+interleaved_batch::~interleaved_batch() {
+	delete[] data;
+}
+
+void interleaved_set_mpf(interleaved_batch& batch, int j, const mpf_class& x) {
+	mpz_class v, limb;
+	mpf_to_fixed(v.get_mpz_t(), x.get_mpf_t(), batch.frac_bits);
+	// two's complement on limbs*limb_bits bits
+	if (v < 0) {
+		mpz_class modulus;
+		mpz_ui_pow_ui(modulus.get_mpz_t(), 2, mp_bitcnt_t(batch.limbs) * batch.limb_bits);
+		v += modulus;
+	}
+	for (int i = 0; i < batch.limbs; i++) {
+		mpz_fdiv_r_2exp(limb.get_mpz_t(), v.get_mpz_t(), batch.limb_bits);
+		batch.data[size_t(i) * batch.stride + j] = mpz_get_ui(limb.get_mpz_t());
+		mpz_fdiv_q_2exp(v.get_mpz_t(), v.get_mpz_t(), batch.limb_bits);
+	}
+}
+
+mpf_class interleaved_get_mpf(const interleaved_batch& batch, int j) {
+	mpz_class v = 0;
+	for (int i = batch.limbs; i-- > 0; ) {
+		v <<= batch.limb_bits;
+		v += (unsigned long)batch.data[size_t(i) * batch.stride + j];
+	}
+	// The top bit of the integer limb is the sign.
+	mp_bitcnt_t width = mp_bitcnt_t(batch.limbs) * batch.limb_bits;
+	if (mpz_tstbit(v.get_mpz_t(), width - 1)) {
+		mpz_class modulus;
+		mpz_ui_pow_ui(modulus.get_mpz_t(), 2, width);
+		v -= modulus;
+	}
+	mpf_class result(0, batch.frac_bits + batch.limb_bits);
+	fixed_to_mpf(result.get_mpf_t(), v.get_mpz_t(), batch.frac_bits);
+	return result;
+}
+
+
+/*------------------------------- Backends -------------------------------*/
+
+
+// A backend has the vector type V of width lanes of uint64_t, the limb bits, and madd, which adds the low
+// limb_bits bits of a*b to lo and the high ones to hi, for a and b less than 2^limb_bits.
+
+template <int BITS>
+struct interleaved_scalar {
+	typedef uint64_t V;
+	static const int width = 1;
+	static const int bits = BITS;
+	static V zero() { return 0; }
+	static V set1(uint64_t a) { return a; }
+	static V load(const uint64_t* p) { return *p; }
+	static void store(uint64_t* p, V a) { *p = a; }
+	static V add(V a, V b) { return a + b; }
+	static V sub(V a, V b) { return a - b; }
+	static V bit_and(V a, V b) { return a & b; }
+	static V bit_xor(V a, V b) { return a ^ b; }
+	static V shift_limb(V a) { return a >> BITS; }
+	static V shift_sign(V a) { return a >> (BITS - 1); }
+	static void madd(V& lo, V& hi, V a, V b) {
+		unsigned __int128 p = (unsigned __int128)a * b;
+		lo += uint64_t(p) & ((uint64_t(1) << BITS) - 1);
+		hi += uint64_t(p >> BITS);
+	}
+};
+
+#if defined(__AVX512IFMA__)
+struct interleaved_ifma {
+	typedef __m512i V;
+	static const int width = 8;
+	static const int bits = 52;
+	static V zero() { return _mm512_setzero_si512(); }
+	static V set1(uint64_t a) { return _mm512_set1_epi64(a); }
+	static V load(const uint64_t* p) { return _mm512_loadu_si512(p); }
+	static void store(uint64_t* p, V a) { _mm512_storeu_si512(p, a); }
+	static V add(V a, V b) { return _mm512_add_epi64(a, b); }
+	static V sub(V a, V b) { return _mm512_sub_epi64(a, b); }
+	static V bit_and(V a, V b) { return _mm512_and_si512(a, b); }
+	static V bit_xor(V a, V b) { return _mm512_xor_si512(a, b); }
+	static V shift_limb(V a) { return _mm512_srli_epi64(a, 52); }
+	static V shift_sign(V a) { return _mm512_srli_epi64(a, 51); }
+	static void madd(V& lo, V& hi, V a, V b) {
+		lo = _mm512_madd52lo_epu64(lo, a, b);
+		hi = _mm512_madd52hi_epu64(hi, a, b);
+	}
+};
+typedef interleaved_ifma interleaved_lanes;
+#elif defined(__AVX512F__)
+struct interleaved_avx512 {
+	typedef __m512i V;
+	static const int width = 8;
+	static const int bits = 32;
+	static V zero() { return _mm512_setzero_si512(); }
+	static V set1(uint64_t a) { return _mm512_set1_epi64(a); }
+	static V load(const uint64_t* p) { return _mm512_loadu_si512(p); }
+	static void store(uint64_t* p, V a) { _mm512_storeu_si512(p, a); }
+	static V add(V a, V b) { return _mm512_add_epi64(a, b); }
+	static V sub(V a, V b) { return _mm512_sub_epi64(a, b); }
+	static V bit_and(V a, V b) { return _mm512_and_si512(a, b); }
+	static V bit_xor(V a, V b) { return _mm512_xor_si512(a, b); }
+	static V shift_limb(V a) { return _mm512_srli_epi64(a, 32); }
+	static V shift_sign(V a) { return _mm512_srli_epi64(a, 31); }
+	static void madd(V& lo, V& hi, V a, V b) {
+		V p = _mm512_mul_epu32(a, b);
+		lo = _mm512_add_epi64(lo, _mm512_and_si512(p, _mm512_set1_epi64(0xffffffff)));
+		hi = _mm512_add_epi64(hi, _mm512_srli_epi64(p, 32));
+	}
+};
+typedef interleaved_avx512 interleaved_lanes;
+#elif defined(__AVX2__)
+struct interleaved_avx2 {
+	typedef __m256i V;
+	static const int width = 4;
+	static const int bits = 32;
+	static V zero() { return _mm256_setzero_si256(); }
+	static V set1(uint64_t a) { return _mm256_set1_epi64x(a); }
+	static V load(const uint64_t* p) { return _mm256_loadu_si256((const __m256i*)p); }
+	static void store(uint64_t* p, V a) { _mm256_storeu_si256((__m256i*)p, a); }
+	static V add(V a, V b) { return _mm256_add_epi64(a, b); }
+	static V sub(V a, V b) { return _mm256_sub_epi64(a, b); }
+	static V bit_and(V a, V b) { return _mm256_and_si256(a, b); }
+	static V bit_xor(V a, V b) { return _mm256_xor_si256(a, b); }
+	static V shift_limb(V a) { return _mm256_srli_epi64(a, 32); }
+	static V shift_sign(V a) { return _mm256_srli_epi64(a, 31); }
+	static void madd(V& lo, V& hi, V a, V b) {
+		V p = _mm256_mul_epu32(a, b);
+		lo = _mm256_add_epi64(lo, _mm256_and_si256(p, _mm256_set1_epi64x(0xffffffff)));
+		hi = _mm256_add_epi64(hi, _mm256_srli_epi64(p, 32));
+	}
+};
+typedef interleaved_avx2 interleaved_lanes;
+#else
+typedef interleaved_scalar<52> interleaved_lanes;
+#endif
+
+int interleaved_limb_bits() {
+	return interleaved_lanes::bits;
+}
+
+string interleaved_lane_name() {
+#if defined(__AVX512IFMA__)
+	return "AVX-512 IFMA, 52-bit limbs, 8 lanes";
+#elif defined(__AVX512F__)
+	return "AVX-512F, 32-bit limbs, 8 lanes";
+#elif defined(__AVX2__)
+	return "AVX2, 32-bit limbs, 4 lanes";
+#else
+	return "scalar, 52-bit limbs, 1 lane";
+#endif
+}
+
+
+/*------------------------------- Kernels -------------------------------*/
+
+
+// Bring every limb of a below 2^bits, from the lowest one up; the carry out of the top limb is dropped (modulo).
+template <class L>
+inline void interleaved_normalize(typename L::V* a, int n) {
+	typedef typename L::V V;
+	V mask = L::set1((uint64_t(1) << L::bits) - 1);
+	V carry = L::zero();
+	for (int i = 0; i < n; i++) {
+		V t = L::add(a[i], carry);
+		carry = L::shift_limb(t);
+		a[i] = L::bit_and(t, mask);
+	}
+}
+
+// r = 2a
+template <class L>
+inline void interleaved_twice(typename L::V* r, const typename L::V* a, int n) {
+	for (int i = 0; i < n; i++) {
+		r[i] = L::add(a[i], a[i]);
+	}
+	interleaved_normalize<L>(r, n);
+}
+
+// r = a - b = a + ~b + 1
+template <class L>
+inline void interleaved_sub(typename L::V* r, const typename L::V* a, const typename L::V* b, int n) {
+	typedef typename L::V V;
+	V mask = L::set1((uint64_t(1) << L::bits) - 1);
+	for (int i = 0; i < n; i++) {
+		r[i] = L::add(a[i], L::bit_xor(b[i], mask));
+	}
+	r[0] = L::add(r[0], L::set1(1));
+	interleaved_normalize<L>(r, n);
+}
+
+// r = -a in the lanes where s is 1, and r = a where s is 0: a xor the mask of s, plus s.
+template <class L>
+inline void interleaved_conditional_negate(typename L::V* r, const typename L::V* a, typename L::V s, int n) {
+	typedef typename L::V V;
+	V mask = L::bit_and(L::sub(L::zero(), s), L::set1((uint64_t(1) << L::bits) - 1));
+	r[0] = L::add(L::bit_xor(a[0], mask), s);
+	for (int i = 1; i < n; i++) {
+		r[i] = L::bit_xor(a[i], mask);
+	}
+	interleaved_normalize<L>(r, n);
+}
+
+// r = a*b / 2^F on the magnitudes, column by column: the column k is the sum of the low parts of ai*bj with
+// i + j = k and of the high parts with i + j = k - 1. Only the products with i + j >= n - 2 are added, as fixed_prec_mul.
+template <class L>
+inline void interleaved_mul(typename L::V* r, const typename L::V* a, const typename L::V* b, int n) {
+	typedef typename L::V V;
+	V ma[INTERLEAVED_MAX_LIMBS], mb[INTERLEAVED_MAX_LIMBS], column[2*INTERLEAVED_MAX_LIMBS];
+	V sa = L::shift_sign(a[n - 1]);
+	V sb = L::shift_sign(b[n - 1]);
+	interleaved_conditional_negate<L>(ma, a, sa, n);
+	interleaved_conditional_negate<L>(mb, b, sb, n);
+	for (int k = 0; k < 2*n; k++) {
+		column[k] = L::zero();
+	}
+	for (int i = 0; i < n; i++) {
+		for (int j = (i < n - 2) ? n - 2 - i : 0; j < n; j++) {
+			L::madd(column[i + j], column[i + j + 1], ma[i], mb[j]);
+		}
+	}
+	interleaved_normalize<L>(column + n - 2, n + 2);
+	interleaved_conditional_negate<L>(r, column + n - 1, L::bit_xor(sa, sb), n);
+}
+
+// r = a^2 / 2^F, as interleaved_mul, with the products ai*aj (i < j) added once and the columns doubled.
+template <class L>
+inline void interleaved_sqr(typename L::V* r, const typename L::V* a, int n) {
+	typedef typename L::V V;
+	V ma[INTERLEAVED_MAX_LIMBS], column[2*INTERLEAVED_MAX_LIMBS];
+	interleaved_conditional_negate<L>(ma, a, L::shift_sign(a[n - 1]), n);
+	for (int k = 0; k < 2*n; k++) {
+		column[k] = L::zero();
+	}
+	for (int i = 0; i < n; i++) {
+		for (int j = (i < n - 2 - i) ? n - 2 - i : i + 1; j < n; j++) {
+			L::madd(column[i + j], column[i + j + 1], ma[i], ma[j]);
+		}
+	}
+	for (int k = n - 2; k < 2*n; k++) {
+		column[k] = L::add(column[k], column[k]);
+	}
+	for (int i = (n - 1) / 2; i < n; i++) {
+		L::madd(column[2*i], column[2*i + 1], ma[i], ma[i]);
+	}
+	interleaved_normalize<L>(column + n - 2, n + 2);
+	for (int i = 0; i < n; i++) {
+		r[i] = column[n - 1 + i];
+	}
+}
+
+// The numbers j0 to j0 + width - 1 of result = Tn(x), as chebyshev_doubling_fixed_mpz.
+template <class L>
+void interleaved_ladder(interleaved_batch& result, const interleaved_batch& x_batch, int j0, const mpz_class& n) {
+	typedef typename L::V V;
+	int limbs = x_batch.limbs;
+	V x[INTERLEAVED_MAX_LIMBS], one[INTERLEAVED_MAX_LIMBS];
+	V t_k[INTERLEAVED_MAX_LIMBS], t_k1[INTERLEAVED_MAX_LIMBS], t_odd[INTERLEAVED_MAX_LIMBS];
+	for (int i = 0; i < limbs; i++) {
+		x[i] = L::load(x_batch.data + size_t(i) * x_batch.stride + j0);
+		one[i] = L::zero();
+	}
+	one[limbs - 1] = L::set1(1);
+	for (int i = 0; i < limbs; i++) {
+		t_k[i] = one[i];	//T0(x)
+		t_k1[i] = x[i];	//T1(x)
+	}
+
+	// Tn(x) = T-n(x). Every lane has the same n, so they follow the same bits.
+	mpz_t abs_n;
+	mpz_roinit_n(abs_n, mpz_limbs_read(n.get_mpz_t()), mpz_size(n.get_mpz_t()));
+	for (mp_bitcnt_t b = mpz_sizeinbase(abs_n, 2); b-- > 0; ) {
+		// T2k+1(x) = 2Tk(x)Tk+1(x) - x
+		interleaved_mul<L>(t_odd, t_k, t_k1, limbs);
+		interleaved_twice<L>(t_odd, t_odd, limbs);
+		interleaved_sub<L>(t_odd, t_odd, x, limbs);
+		// (Tk, Tk+1) -> (T2k+1, T2k+2) for the bit 1, and (T2k, T2k+1) for the bit 0:
+		// the square 2T^2 - 1 of one of them in place, and T2k+1 for the other one.
+		bool bit = mpz_tstbit(abs_n, b);
+		V* t_square = bit ? t_k1 : t_k;
+		V* t_other = bit ? t_k : t_k1;
+		interleaved_sqr<L>(t_square, t_square, limbs);
+		interleaved_twice<L>(t_square, t_square, limbs);
+		interleaved_sub<L>(t_square, t_square, one, limbs);
+		for (int i = 0; i < limbs; i++) {
+			t_other[i] = t_odd[i];
+		}
+	}
+	for (int i = 0; i < limbs; i++) {
+		L::store(result.data + size_t(i) * result.stride + j0, t_k[i]);
+	}
+}
+
+
+/*------------------------------- Chebyshev Doubling on Limb-Interleaved Batches -------------------------------*/
+
+
+// The reference with the limb bits of the batch.
+void chebyshev_doubling_interleaved_reference(interleaved_batch& result, const interleaved_batch& x, const mpz_class& n) {
+	for (int j = 0; j < x.count; j++) {
+		if (x.limb_bits == 32) {
+			interleaved_ladder<interleaved_scalar<32> >(result, x, j, n);
+		}
+		else {
+			interleaved_ladder<interleaved_scalar<52> >(result, x, j, n);
+		}
+	}
+}
+
+void chebyshev_doubling_interleaved(interleaved_batch& result, const interleaved_batch& x, const mpz_class& n) {
+	if (x.limb_bits != interleaved_lanes::bits) {
+		chebyshev_doubling_interleaved_reference(result, x, n);
+		return;
+	}
+	// The stride is a multiple of the lanes, and the numbers after count are zeros.
+	for (int j = 0; j < x.count; j += interleaved_lanes::width) {
+		interleaved_ladder<interleaved_lanes>(result, x, j, n);
+	}
+}
@@ -0,0 +1,78 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This Program is the Limb-Interleaved Part of the Library of our Chebyshev Article.
+// Many independent evaluations at the same precision (the nonces of the blocks, the sweeps, the keys) are many
+// chains of GMP calls on the same sizes. Here a batch of count fixed-point numbers in [-1, 1] is stored limb by limb:
+// the limb i of every number is together, so a vector register holds the limb i of 4 or 8 numbers, and the
+// schoolbook product works on the lanes as the scalar one works on one number ("vertical" SIMD).
+// The limbs have limb_bits bits in 64-bit words, so that the columns of a product add up without carries:
+// - 52 bits with AVX-512 IFMA (vpmadd52luq/vpmadd52huq give the low and high 52 bits of a 52x52 product), 8 lanes;
+// - 32 bits with AVX-512F or AVX2 (vpmuludq gives the 64 bits of a 32x32 product), 8 or 4 lanes;
+// - 52 bits in the scalar code (unsigned __int128) without them.
+// The backend is chosen when compiling (-march=native). The same kernel on one number at a time, with the same limbs,
+// is the scalar reference, which gives exactly the same bits.
+// The numbers are in two's complement with limbs least significant first: the top limb is the integer part, the other
+// ones are F = limb_bits*(limbs-1) fractional bits. The products are truncated as fixed_prec_mul of chebyshev_fixed.hpp,
+// with an error less than (limbs-1)2^-F, so the error bound of the doubling method there holds with u = (limbs-1)2^-F.
+#ifndef CHEBYSHEV_INTERLEAVED_HPP
+#define CHEBYSHEV_INTERLEAVED_HPP
+
+#include <iostream>
+#include <string>
+#include <cstdint>
+
+#include <gmpxx.h>
+#include "chebyshev.hpp"
+#include "chebyshev_fixed.hpp"
+
+using namespace std;
+
+// The largest number of limbs of a number: 3276 fractional bits with 52-bit limbs, 2016 with 32-bit limbs.
+// The kernels keep their limbs on the stack in arrays of this size.
+#define INTERLEAVED_MAX_LIMBS 64
+
+// The most lanes of a backend, count is rounded up to it so that the last lanes read zeros.
+#define INTERLEAVED_MAX_LANES 8
+
+
+/*------------------------------- Limb-Interleaved Batches -------------------------------*/
+
+
+// The limb i of the number j is data[i*stride + j].
+struct interleaved_batch {
+	int count;
+	int stride;
+	int limbs;
+	int limb_bits;
+	mp_bitcnt_t frac_bits;
+	uint64_t* data;
+
+	// count zeros with at least prec fractional bits, in limbs of limb_bits bits. The limbs are clamped to
+	// INTERLEAVED_MAX_LIMBS, so a larger prec gets only frac_bits < prec fractional bits: check frac_bits.
+	interleaved_batch(int count, mp_bitcnt_t prec, int limb_bits);
+	~interleaved_batch();
+	interleaved_batch(const interleaved_batch&) = delete;
+	interleaved_batch& operator=(const interleaved_batch&) = delete;
+};
+
+// The limb bits and the name of the backend of this compilation.
+int interleaved_limb_bits();
+string interleaved_lane_name();
+
+// The number j = x truncated to F bits, and back to mpf with the precision F + limb_bits.
+void interleaved_set_mpf(interleaved_batch& batch, int j, const mpf_class& x);
+mpf_class interleaved_get_mpf(const interleaved_batch& batch, int j);
+
+
+/*------------------------------- Chebyshev Doubling on Limb-Interleaved Batches -------------------------------*/
+
+
+// result[j] = Tn(x[j]) for every j by the (Tk, Tk+1) ladder, the lanes of the backend at a time.
+// result has the shape of x. If x does not have the limb bits of the backend, it runs the scalar reference.
+void chebyshev_doubling_interleaved(interleaved_batch& result, const interleaved_batch& x, const mpz_class& n);
+
+// The same, one number at a time with the scalar kernel, for cross-checking.
+void chebyshev_doubling_interleaved_reference(interleaved_batch& result, const interleaved_batch& x, const mpz_class& n);
+
+#endif
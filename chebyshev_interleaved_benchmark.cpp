@@ -0,0 +1,138 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This program measures the limb-interleaved batches of chebyshev_interleaved.hpp: <number of x> independent Ts(x)
+// at the same precision, for m from 30 to 600 digits. For every m it compares the evaluations per second of
+// chebyshev_doubling (mpf) and chebyshev_doubling_fixed (mpz) one x at a time, of the scalar reference on the batch,
+// and of the lanes of the backend on the batch. It checks that the lanes give exactly the bits of the scalar
+// reference, and prints the largest error of the batch against mpf with twice the precision (on the first 64 x),
+// as a power of 2 since at m = 600 it is below the smallest double.
+// The backend needs -march=native (AVX-512 IFMA, AVX-512F or AVX2), otherwise the lanes are the scalar code.
+
+// In order to compile and run this program, you need to install two libraries: GMP and MPFR.
+// Compile: g++ -O2 -march=native -o chebyshev_interleaved_benchmark chebyshev_interleaved_benchmark.cpp chebyshev.cpp chebyshev_fixed.cpp chebyshev_interleaved.cpp -lmpfr -lgmpxx -lgmp
+// Run: ./chebyshev_interleaved_benchmark <length of secret key> <number of x> (s = 10^length)
+#include <iostream>
+#include <string>
+#include <random>
+
+#include <gmpxx.h>
+#include <mpreal.h>
+#include "chebyshev.hpp"
+#include "chebyshev_fixed.hpp"
+#include "chebyshev_interleaved.hpp"
+
+#include <time.h>
+
+using namespace std;
+
+// log2 of |a|, or a very negative number for 0.
+long log2_mpf(const mpf_class& a) {
+	if (a == 0) {
+		return -1000000;
+	}
+	long power;
+	mpf_get_d_2exp(&power, a.get_mpf_t());
+	return power;
+}
+
+int main (int argc, char* argv[]) {
+	int n_s, count;
+	if (argc == 3) {
+		n_s = atoi(argv[1]);
+		count = atoi(argv[2]);
+	}
+	else {
+		cout << "Notice: If you want to run this program, you need 2 inputs, such that: " << endl;
+		cout << "Example: ./chebyshev_interleaved_benchmark <length of secret key> <number of x> (s = 10^length) " << endl;
+		cout << "For example: ./chebyshev_interleaved_benchmark 8 1024" << endl;
+		return 0;
+	}
+
+	mpz_class s;
+	mpz_ui_pow_ui(s.get_mpz_t(), 10, n_s);
+	cout << "s = 10^" << n_s << ", " << count << " x, backend: " << interleaved_lane_name() << endl;
+
+	int n_precisions = 6;
+	int precisions[] = {30, 60, 100, 200, 300, 600};
+	mt19937_64 generator(2026);
+	uniform_real_distribution<double> uniform(-1.0, 1.0);
+	clock_t start, end;
+	cout.precision(6);
+	cout << endl << "m, limbs, mpf evaluations/s, mpz evaluations/s, reference evaluations/s, lanes evaluations/s, ";
+	cout << "speedup against mpf, mismatches, largest error" << endl;
+
+	for (int p = 0; p < n_precisions; p++) {
+		int n_digits_m = precisions[p];
+		mp_bitcnt_t prec = digits2bit_mpf(n_digits_m);
+		chebyshev_context ctx(prec);
+		fixed_context fixed(prec);
+		interleaved_batch x_batch(count, prec, interleaved_limb_bits());
+		interleaved_batch y_reference(count, prec, interleaved_limb_bits());
+		interleaved_batch y_lanes(count, prec, interleaved_limb_bits());
+		if (x_batch.frac_bits < prec) {
+			cout << n_digits_m << ", more than the " << INTERLEAVED_MAX_LIMBS << " limbs of a batch, skipped" << endl;
+			continue;
+		}
+
+		// x with all m digits, truncated to the batch, such that every engine starts from the same x.
+		mpf_class* x_list = new mpf_class[count];
+		for (int j = 0; j < count; j++) {
+			x_list[j] = mpf_class(uniform(generator), prec);
+			x_list[j] += mpf_class(uniform(generator), prec) * 1e-17;
+			interleaved_set_mpf(x_batch, j, x_list[j]);
+			x_list[j] = interleaved_get_mpf(x_batch, j);
+		}
+
+		mpf_class y;
+		start = clock();
+		for (int j = 0; j < count; j++) {
+			y = chebyshev_doubling(ctx, x_list[j], s);
+		}
+		end = clock();
+		double time_mpf = double(end - start)/CLOCKS_PER_SEC;
+
+		start = clock();
+		for (int j = 0; j < count; j++) {
+			y = chebyshev_doubling_fixed(fixed, x_list[j], s);
+		}
+		end = clock();
+		double time_mpz = double(end - start)/CLOCKS_PER_SEC;
+
+		start = clock();
+		chebyshev_doubling_interleaved_reference(y_reference, x_batch, s);
+		end = clock();
+		double time_reference = double(end - start)/CLOCKS_PER_SEC;
+
+		start = clock();
+		chebyshev_doubling_interleaved(y_lanes, x_batch, s);
+		end = clock();
+		double time_lanes = double(end - start)/CLOCKS_PER_SEC;
+
+		int mismatches = 0;
+		for (int j = 0; j < count; j++) {
+			for (int i = 0; i < x_batch.limbs; i++) {
+				if (y_lanes.data[size_t(i) * y_lanes.stride + j] != y_reference.data[size_t(i) * y_reference.stride + j]) {
+					mismatches++;
+					break;
+				}
+			}
+		}
+
+		chebyshev_context reference(2*prec + 64);
+		mpf_class largest_error = 0;
+		for (int j = 0; j < count && j < 64; j++) {
+			mpf_class x_reference(x_list[j], 2*prec + 64);
+			mpf_class error = abs(interleaved_get_mpf(y_lanes, j) - chebyshev_doubling(reference, x_reference, s));
+			if (error > largest_error)
+				largest_error = error;
+		}
+
+		cout << n_digits_m << ", " << x_batch.limbs << ", " << count / time_mpf << ", " << count / time_mpz << ", ";
+		cout << count / time_reference << ", " << count / time_lanes << ", " << time_mpf / time_lanes << ", ";
+		cout << mismatches << ", 2^" << log2_mpf(largest_error) << endl;
+		delete[] x_list;
+	}
+
+	return 0;
+}
@@ -0,0 +1,210 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This program is the micro-benchmark suite of the kernels of chebyshev.hpp: chebyshev_expensive, chebyshev_economical,
+// matrix_multiplication, matrix_power, binary_representation, message_to_binary_list and binary_list_to_message.
+// In the run mode, every kernel is measured at m = 30, 120 and 1000 digits and at several sizes: the length of the
+// degree n = 10^size for the Chebyshev, matrix and binary kernels (1 for one matrix product), and the bytes of the
+// message for the message kernels (with m/8 chars per group as chebyshev_encryption_block). Every case is run <warmup>
+// times without timing, then <repetitions> times, each timed in wall-clock time, and the JSON file has one record per
+// case with min, median, p90, p99, max and mean in seconds (summarize_latencies of chebyshev_parallel.hpp).
+// In the compare mode, the cases of the two files are matched by (kernel, digits, size), and a case is a regression
+// if its median in the current file is more than <threshold> percent above the baseline; the program then returns 1.
+
+// In order to compile and run this program, you need to install two libraries: GMP and MPFR.
+// Compile: g++ -o chebyshev_kernel_benchmark chebyshev_kernel_benchmark.cpp chebyshev.cpp chebyshev_parallel.cpp -lmpfr -lgmpxx -lgmp -pthread
+// Run: ./chebyshev_kernel_benchmark run <output json> <repetitions> <warmup>
+//      ./chebyshev_kernel_benchmark compare <baseline json> <current json> <threshold percent>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <functional>
+
+#include <gmpxx.h>
+#include <mpreal.h>
+#include "chebyshev.hpp"
+#include "chebyshev_parallel.hpp"
+
+using namespace std;
+
+// One case of the suite and its timings.
+struct kernel_case {
+	string kernel;
+	int digits;
+	int size;
+	latency_summary summary;
+};
+
+// Call body warmup times, then repetitions times with a wall-clock timing of every call.
+latency_summary time_kernel(int repetitions, int warmup, function<void()> body) {
+	for (int i = 0; i < warmup; i++) {
+		body();
+	}
+	vector<double> seconds;
+	for (int i = 0; i < repetitions; i++) {
+		auto start = chrono::steady_clock::now();
+		body();
+		seconds.push_back(chrono::duration<double>(chrono::steady_clock::now() - start).count());
+	}
+	return summarize_latencies(seconds);
+}
+
+string kernel_case_json(const kernel_case& c) {
+	ostringstream out;
+	out.precision(6);
+	out << "{\"kernel\": \"" << c.kernel << "\", \"digits\": " << c.digits << ", \"size\": " << c.size;
+	out << ", \"min\": " << c.summary.min << ", \"median\": " << c.summary.median << ", \"p90\": " << c.summary.p90;
+	out << ", \"p99\": " << c.summary.p99 << ", \"max\": " << c.summary.max << ", \"mean\": " << c.summary.mean << "}";
+	return out.str();
+}
+
+// The value after "key": in line, without the quotes of a string.
+string json_field(const string& line, const string& key) {
+	size_t a = line.find("\"" + key + "\": ");
+	if (a == string::npos) {
+		return "";
+	}
+	a += key.length() + 4;
+	if (line[a] == '"') {
+		return line.substr(a + 1, line.find('"', a + 1) - a - 1);
+	}
+	return line.substr(a, line.find_first_of(",}", a) - a);
+}
+
+// The medians of a file of the run mode, by "kernel digits size". Every record is on its own line.
+bool read_medians(const string& path, map<string, double>& medians) {
+	ifstream in(path);
+	if (!in) {
+		return false;
+	}
+	string line;
+	while (getline(in, line)) {
+		string kernel = json_field(line, "kernel");
+		if (kernel.empty())
+			continue;
+		string key = kernel + " " + json_field(line, "digits") + " " + json_field(line, "size");
+		medians[key] = atof(json_field(line, "median").c_str());
+	}
+	return true;
+}
+
+int run_suite(const string& path, int repetitions, int warmup) {
+	ofstream out(path);
+	if (!out) {
+		cout << "Cannot write " << path << endl;
+		return 1;
+	}
+	vector<kernel_case> cases;
+	int precisions[] = {30, 120, 1000};
+	for (int n_digits_m : precisions) {
+		mpf_set_default_prec(digits2bit_mpf(n_digits_m));
+		string x_string = "1";
+		while (x_string.length() < n_digits_m)
+			x_string += "1";
+		mpf_class x("0." + x_string, mpf_get_default_prec(), 10);
+		auto add_case = [&](const string& kernel, int size, function<void()> body) {
+			kernel_case c = {kernel, n_digits_m, size, time_kernel(repetitions, warmup, body)};
+			cout << kernel_case_json(c) << endl;
+			cases.push_back(c);
+		};
+		auto power_of_ten = [](int length) {
+			mpz_class n;
+			mpz_ui_pow_ui(n.get_mpz_t(), 10, length);
+			return n;
+		};
+
+		// The expensive method and matrix_power are linear in n.
+		for (int size : {2, 3, 4}) {
+			mpz_class n = power_of_ten(size);
+			add_case("chebyshev_expensive", size, [&]() { chebyshev_expensive(x, n); });
+		}
+		for (int size : {2, 4, 8, 32}) {
+			mpz_class n = power_of_ten(size);
+			add_case("chebyshev_economical", size, [&]() { chebyshev_economical(x, n); });
+		}
+		mpf_class u[4], v[4];
+		auto set_mx = [&](mpf_class* a) {
+			a[0] = 0;
+			a[1] = -1;
+			a[2] = 1;
+			a[3] = 2*x;
+		};
+		set_mx(v);
+		add_case("matrix_multiplication", 1, [&]() { set_mx(u); matrix_multiplication(u, v); });
+		for (int size : {2, 3}) {
+			mpz_class n = power_of_ten(size);
+			add_case("matrix_power", size, [&]() { set_mx(u); matrix_power(u, n); });
+		}
+		for (int size : {8, 32, 128, 1024}) {
+			mpz_class n = power_of_ten(size);
+			// len_n digits of n take at most 4*len_n bits.
+			add_case("binary_representation", size, [&]() { delete[] binary_representation(n, size); });
+		}
+
+		int char_n_per_group = max(n_digits_m / 8, 1);
+		for (int size : {1024, 65536}) {
+			string message;
+			for (int i = 0; i < size; i++)
+				message += char('a' + i % 26);
+			int binary_list_n = (size + char_n_per_group - 1) / char_n_per_group;
+			add_case("message_to_binary_list", size, [&]() { delete[] message_to_binary_list(message, binary_list_n, char_n_per_group); });
+			// binary_list_to_message takes the digits of the groups, without "0.".
+			string* binary_list = message_to_binary_list(message, binary_list_n, char_n_per_group);
+			for (int i = 0; i < binary_list_n; i++)
+				binary_list[i].erase(0, 2);
+			add_case("binary_list_to_message", size, [&]() { binary_list_to_message(binary_list, binary_list_n); });
+			delete[] binary_list;
+		}
+	}
+
+	out << "{\"suite\": \"chebyshev_kernel_benchmark\", \"repetitions\": " << repetitions << ", \"warmup\": " << warmup << ", \"cases\": [" << endl;
+	for (size_t i = 0; i < cases.size(); i++) {
+		out << kernel_case_json(cases[i]) << (i + 1 < cases.size() ? "," : "") << endl;
+	}
+	out << "]}" << endl;
+	return 0;
+}
+
+int compare_suites(const string& baseline_path, const string& current_path, double threshold) {
+	map<string, double> baseline, current;
+	if (!read_medians(baseline_path, baseline) || !read_medians(current_path, current)) {
+		cout << "Cannot read " << baseline_path << " or " << current_path << endl;
+		return 1;
+	}
+	int regressions = 0;
+	cout.precision(6);
+	cout << "kernel digits size, baseline median, current median, change %, status" << endl;
+	for (auto& entry : current) {
+		auto found = baseline.find(entry.first);
+		if (found == baseline.end()) {
+			cout << entry.first << ", -, " << entry.second << ", -, new" << endl;
+			continue;
+		}
+		double change = (entry.second / found->second - 1) * 100;
+		bool regression = change > threshold;
+		regressions += regression;
+		cout << entry.first << ", " << found->second << ", " << entry.second << ", " << change << ", ";
+		cout << (regression ? "REGRESSION" : "ok") << endl;
+	}
+	cout << regressions << " regressions above " << threshold << "%" << endl;
+	return regressions > 0 ? 1 : 0;
+}
+
+int main (int argc, char* argv[]) {
+	string mode = (argc == 5) ? argv[1] : "";
+	if (mode == "run" && atoi(argv[3]) > 0 && atoi(argv[4]) >= 0) {
+		return run_suite(argv[2], atoi(argv[3]), atoi(argv[4]));
+	}
+	if (mode == "compare") {
+		return compare_suites(argv[2], argv[3], atof(argv[4]));
+	}
+	cout << "Notice: If you want to run this program, you need 4 inputs, such that: " << endl;
+	cout << "Example: ./chebyshev_kernel_benchmark run <output json> <repetitions> <warmup> " << endl;
+	cout << "Example: ./chebyshev_kernel_benchmark compare <baseline json> <current json> <threshold percent> " << endl;
+	cout << "For example: ./chebyshev_kernel_benchmark run baseline.json 10 2" << endl;
+	return 0;
+}
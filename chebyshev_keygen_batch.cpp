@@ -0,0 +1,101 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This program generates many key pairs at once, in parallel, with keygen_stream of chebyshev_parallel.hpp:
+// <number of keys> triples (x, s, Ts(x)) with x of m digits uniform in (-1, 1), s uniform among the integers of
+// <length of secret key> digits, all the randomness from random_device, on <threads> threads.
+// The pairs (x, Ts(x)) go to a public key file and the s to a private key file in the binary format of chebyshev.hpp,
+// KEYGEN_CHUNK_KEYS keys at a time. It prints the keys per second, then reads the first key back and checks Ts(x).
+// In the benchmark mode, it prints the keys per second at every precision m = 30, 60, 120, 240, 480 and 1000 digits,
+// with the files in memory.
+
+// In order to compile and run this program, you need to install two libraries: GMP and MPFR.
+// Compile: g++ -o chebyshev_keygen_batch chebyshev_keygen_batch.cpp chebyshev.cpp chebyshev_parallel.cpp -lmpfr -lgmpxx -lgmp -pthread
+// Run: ./chebyshev_keygen_batch <number of keys> <length of secret key> <threads> <precision m> <public key file> <private key file>
+//      ./chebyshev_keygen_batch <number of keys> <length of secret key> <threads> benchmark
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <chrono>
+
+#include <gmpxx.h>
+#include <mpreal.h>
+#include "chebyshev.hpp"
+#include "chebyshev_parallel.hpp"
+
+using namespace std;
+
+int main (int argc, char* argv[]) {
+	long long keys_n = 0;
+	int key_length = 0, threads_n = -1, n_digits_m = 0;
+	string mode;
+	if (argc == 5 || argc == 7) {
+		keys_n = atoll(argv[1]);
+		key_length = atoi(argv[2]);
+		threads_n = atoi(argv[3]);
+		mode = argv[4];
+		n_digits_m = atoi(argv[4]);
+	}
+	bool benchmark = (argc == 5 && mode == "benchmark");
+	if ((!benchmark && (argc != 7 || n_digits_m <= 0)) || keys_n <= 0 || key_length <= 0 || threads_n < 0) {
+		cout << "Notice: If you want to run this program, you need 6 inputs, or 4 for the benchmark, such that: " << endl;
+		cout << "Example: ./chebyshev_keygen_batch <number of keys> <length of secret key> <threads> <precision m> <public key file> <private key file> " << endl;
+		cout << "Example: ./chebyshev_keygen_batch <number of keys> <length of secret key> <threads> benchmark (threads 0 for all the cores) " << endl;
+		cout << "For example: ./chebyshev_keygen_batch 10000 8 0 120 keys.public keys.private" << endl;
+		return 0;
+	}
+	if (threads_n == 0) {
+		threads_n = hardware_threads();
+	}
+	thread_pool pool(threads_n);
+	cout.precision(6);
+
+	if (benchmark) {
+		int precisions[] = {30, 60, 120, 240, 480, 1000};
+		cout << "m, keys, threads, seconds, keys/s, public bytes, private bytes" << endl;
+		for (int m : precisions) {
+			ostringstream public_out, private_out;
+			auto start = chrono::steady_clock::now();
+			keygen_stream(pool, digits2bit_mpf(m), key_length, keys_n, public_out, private_out);
+			double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+			cout << m << ", " << keys_n << ", " << threads_n << ", " << seconds << ", " << keys_n / seconds << ", ";
+			cout << public_out.str().size() << ", " << private_out.str().size() << endl;
+		}
+		return 0;
+	}
+
+	ofstream public_out(argv[5], ios::binary);
+	ofstream private_out(argv[6], ios::binary);
+	if (!public_out || !private_out) {
+		cout << "Cannot open " << argv[5] << " or " << argv[6] << endl;
+		return 1;
+	}
+	mp_bitcnt_t prec = digits2bit_mpf(n_digits_m);
+	auto start = chrono::steady_clock::now();
+	bool written = keygen_stream(pool, prec, key_length, keys_n, public_out, private_out);
+	public_out.close();
+	private_out.close();
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	if (!written || !public_out || !private_out) {
+		cout << "Cannot write " << argv[5] << " or " << argv[6] << endl;
+		return 1;
+	}
+	cout << keys_n << " keys of m = " << n_digits_m << " digits and s of " << key_length << " digits with " << threads_n << " threads, ";
+	cout << seconds << "s, " << keys_n / seconds << " keys/s" << endl;
+
+	// Read the first key back, and compute Ts(x) again.
+	ifstream public_in(argv[5], ios::binary);
+	ifstream private_in(argv[6], ios::binary);
+	mpf_class x, y;
+	mpz_class s;
+	if (!read_public_key_binary(public_in, prec, x, y) || !read_private_key_binary(private_in, s)) {
+		cout << "Cannot read the first key back!" << endl;
+		return 1;
+	}
+	chebyshev_context ctx(prec);
+	cout << "First key: s has " << count_digits_mpz(s) << " digits, Ts(x) ";
+	cout << (chebyshev_doubling(ctx, x, s) == y ? "matches" : "does not match") << " y" << endl;
+
+	return 0;
+}
@@ -0,0 +1,109 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This program compares the single-pass binary ladder (chebyshev_ladder) and the doubling method (chebyshev_doubling)
+// with the economical method (chebyshev_economical).
+// For s = 10^8, 10^16, 10^100, ..., 10^100000 it prints the time of the three methods, the speedup and the difference
+// of the ladder and of the doubling method against the economical one,
+// and the number of calculations, which is the same for the ladder and the economical method so the tables of the paper still apply.
+// The economical method rebuilds Mx^(2^k) for every bit of s, so it is only run up to s = 10^<largest length>.
+// Notice that large s needs large m to give a correct Ts(x), here we only care about the time.
+
+// In order to compile and run this program, you need to install two libraries: GMP and MPFR.
+// Compile: g++ -o chebyshev_ladder_benchmark chebyshev_ladder_benchmark.cpp chebyshev.cpp -lmpfr -lgmpxx -lgmp
+// Run: ./chebyshev_ladder_benchmark <precision m> <largest length of s for economical method>
+#include <iostream>
+#include <string>
+
+#include <gmpxx.h>
+#include <mpreal.h>
+#include "chebyshev.hpp"
+
+#include <time.h>
+
+using namespace std;
+
+int main (int argc, char* argv[]) {
+	int n_digits_m, n_s_economical;
+	if (argc == 3) {
+		n_digits_m = atoi(argv[1]);
+		n_s_economical = atoi(argv[2]);
+	}
+	else {
+		cout << "Notice: If you want to run this program, you need 2 inputs, such that: " << endl;
+		cout << "Example: ./chebyshev_ladder_benchmark <precision m> <largest length of s for economical method> (s = 10^length) " << endl;
+		cout << "For example: ./chebyshev_ladder_benchmark 120 1000" << endl;
+		return 0;
+	}
+
+	/*----------------------------------- Preparation/Assignment -----------------------------------*/
+
+	mpf_set_default_prec(digits2bit_mpf(n_digits_m));
+	cout << "Precision m of mpf for computation is: " << mpf_get_default_prec() << ", where 3.2 bit represents one decimal digit in average. ";
+	cout << "Which is " << int(mpf_get_default_prec() / 3.2) << " digits." << endl;
+
+	// Choose x as 0.111... with precision m number of digits.
+	mpf_class x;
+	string tmp_string = "1";
+	string x_string = "1";
+	while (x_string.length() < n_digits_m)
+		x_string += tmp_string;
+	x.set_str((const char*)(("0." + x_string).c_str()), 10);
+
+	cout.precision(count_digits_mpf_decimal(x));
+	cout << "We choose x: " << endl << x << endl << endl;
+	cout.precision(10);
+
+	/*----------------------------------- Start Experiment/Computation -----------------------------------*/
+
+	int n_lengths = 6;
+	int lengths[] = {8, 16, 100, 1000, 10000, 100000};
+
+	clock_t start, end;
+	for (int i = 0; i < n_lengths; i++) {
+		mpz_class s;
+		mpz_ui_pow_ui(s.get_mpz_t(), 10, lengths[i]);
+		cout << "s = 10^" << lengths[i] << endl;
+
+		mpz_class count_ladder = 0;
+		start = clock();
+		mpf_class y_ladder = chebyshev_ladder_count(x, s, count_ladder);
+		end = clock();
+		double time_ladder = double(end - start)/CLOCKS_PER_SEC;
+		cout << "Ladder:     time = " << time_ladder << "s, number of calculations = " << count_ladder << endl;
+
+		mpz_class count_doubling = 0;
+		start = clock();
+		mpf_class y_doubling = chebyshev_doubling_count(x, s, count_doubling);
+		end = clock();
+		double time_doubling = double(end - start)/CLOCKS_PER_SEC;
+		cout << "Doubling:   time = " << time_doubling << "s, number of calculations = " << count_doubling << endl;
+
+		if (lengths[i] > n_s_economical) {
+			cout << "Economical: skipped, length of s is greater than " << n_s_economical << endl << endl;
+			continue;
+		}
+
+		mpz_class count_economical = 0;
+		start = clock();
+		mpf_class y_economical = chebyshev_economical_count(x, s, count_economical);
+		end = clock();
+		double time_economical = double(end - start)/CLOCKS_PER_SEC;
+		cout << "Economical: time = " << time_economical << "s, number of calculations = " << count_economical << endl;
+
+		cout << "Speedup = " << time_economical / time_ladder << endl;
+		cout << "Speedup of doubling = " << time_economical / time_doubling << endl;
+		// When s is too large for precision m both results are far from [-1, 1], and printing such mpf
+		// with cout takes enormous memory, so we print the difference as a double.
+		mpf_class difference = y_ladder - y_economical;
+		cout << "Difference = " << difference.get_d() << endl;
+		difference = y_doubling - y_economical;
+		cout << "Difference of doubling = " << difference.get_d() << endl;
+		if (count_ladder != count_economical) {
+			cout << "The number of calculations is different!!" << endl;
+		}
+		cout << endl;
+	}
+
+	return 0;
+}
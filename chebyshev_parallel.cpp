@@ -0,0 +1,736 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This Program is the Parallel Part of the Library of our Chebyshev Article: a work-stealing thread pool,
+// and the block encryption & decryption, the parameter sweeps, the trials, the segmented verifier and the key generation
+// running on it.
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <climits>
+#include <random>
+
+#include <gmpxx.h>
+#include "chebyshev.hpp"
+#include "chebyshev_parallel.hpp"
+
+using namespace std;
+
+
+/*------------------------------- Work-Stealing Thread Pool -------------------------------*/
+
+
+// Take a task for the worker id: first from the back of its own queue, then from the front of the other ones.
+bool thread_pool_take(thread_pool& pool, int id, function<void(int)>& task) {
+	for (int k = 0; k < pool.threads_n; k++) {
+		worker_queue& q = *pool.queues[(id + k) % pool.threads_n];
+		lock_guard<mutex> lock(q.m);
+		if (q.tasks.empty()) {
+			continue;
+		}
+		if (k == 0) {
+			task = move(q.tasks.back());
+			q.tasks.pop_back();
+		}
+		else {
+			task = move(q.tasks.front());
+			q.tasks.pop_front();
+		}
+		return true;
+	}
+	return false;
+}
+
+void thread_pool_worker(thread_pool& pool, int id) {
+	function<void(int)> task;
+	while (true) {
+		if (thread_pool_take(pool, id, task)) {
+			{
+				lock_guard<mutex> lock(pool.m);
+				pool.queued--;
+			}
+			task(id);
+			lock_guard<mutex> lock(pool.m);
+			pool.pending--;
+			if (pool.pending == 0) {
+				pool.done_cv.notify_all();
+			}
+			continue;
+		}
+		unique_lock<mutex> lock(pool.m);
+		pool.work_cv.wait(lock, [&pool] { return pool.stop || pool.queued > 0; });
+		if (pool.stop && pool.queued == 0) {
+			return;
+		}
+	}
+}
+
+thread_pool::thread_pool(int threads_n) : threads_n(max(threads_n, 1)), pending(0), queued(0), next_queue(0), stop(false) {
+	for (int i = 0; i < this->threads_n; i++) {
+		queues.push_back(new worker_queue);
+	}
+	for (int i = 0; i < this->threads_n; i++) {
+		threads.push_back(thread(thread_pool_worker, ref(*this), i));
+	}
+}
+
+thread_pool::~thread_pool() {
+	{
+		lock_guard<mutex> lock(m);
+		stop = true;
+	}
+	work_cv.notify_all();
+	for (int i = 0; i < threads.size(); i++) {
+		threads[i].join();
+	}
+	for (int i = 0; i < queues.size(); i++) {
+		delete queues[i];
+	}
+}
+
+// The number of cores, at least 1.
+int hardware_threads() {
+	return max(int(thread::hardware_concurrency()), 1);
+}
+
+// Put a task in the queues of pool, round robin.
+void thread_pool_submit(thread_pool& pool, function<void(int)> task) {
+	int i;
+	{
+		lock_guard<mutex> lock(pool.m);
+		pool.pending++;
+		i = pool.next_queue;
+		pool.next_queue = (pool.next_queue + 1) % pool.threads_n;
+	}
+	{
+		lock_guard<mutex> lock(pool.queues[i]->m);
+		pool.queues[i]->tasks.push_back(move(task));
+	}
+	{
+		lock_guard<mutex> lock(pool.m);
+		pool.queued++;
+	}
+	pool.work_cv.notify_one();
+}
+
+// Wait until every task submitted to pool is finished.
+void thread_pool_wait(thread_pool& pool) {
+	unique_lock<mutex> lock(pool.m);
+	pool.done_cv.wait(lock, [&pool] { return pool.pending == 0; });
+}
+
+// Call body(worker, i) for every 0 <= i < n on pool, by chunks of about n/(8*threads_n), and wait for all of them.
+void parallel_for(thread_pool& pool, long n, function<void(int, long)> body) {
+	long chunk = max(n / (8L * pool.threads_n), 1L);
+	for (long first = 0; first < n; first += chunk) {
+		long last = min(first + chunk, n);
+		thread_pool_submit(pool, [first, last, &body](int worker) {
+			for (long i = first; i < last; i++) {
+				body(worker, i);
+			}
+		});
+	}
+	thread_pool_wait(pool);
+}
+
+
+/*------------------------------- Parallel Block Encryption & Decryption -------------------------------*/
+
+
+// Encrypt every block with its own nonce r_i between s/2 and s, at the precision prec of computation.
+void block_encrypt_parallel(thread_pool& pool, mp_bitcnt_t prec, const mpf_class& x, const mpf_class& y, const mpz_class& s,
+		const mpz_class& seed, const mpf_class* u_list, int n, mpf_class* z0_list, mpf_class* z2_list) {
+	// Every worker has its own context and random generator.
+	vector<chebyshev_context*> contexts;
+	vector<gmp_randclass*> rands;
+	for (int i = 0; i < pool.threads_n; i++) {
+		contexts.push_back(new chebyshev_context(prec));
+		rands.push_back(new gmp_randclass(gmp_randinit_default));
+	}
+	mpz_class half_s = s / 2;
+	mpz_class seed_base = seed << 64;
+
+	// Seeding the generator is expensive, so the nonces are drawn by chunks of BLOCK_NONCE_CHUNK blocks,
+	// and the stream of chunk c only depends on (seed, c), whichever worker runs it.
+	long chunks_n = (n + BLOCK_NONCE_CHUNK - 1) / BLOCK_NONCE_CHUNK;
+	parallel_for(pool, chunks_n, [&](int worker, long c) {
+		chebyshev_context& ctx = *contexts[worker];
+		gmp_randclass& rand = *rands[worker];
+		rand.seed(seed_base + c);
+
+		long last = min((c + 1) * BLOCK_NONCE_CHUNK, long(n));
+		for (long i = c * BLOCK_NONCE_CHUNK; i < last; i++) {
+			mpz_class r = rand.get_z_range(half_s) + half_s;
+			z0_list[i].set_prec(prec);
+			z0_list[i] = chebyshev_doubling(ctx, x, r);
+			mpf_class z1 = chebyshev_doubling(ctx, y, r);
+			z2_list[i].set_prec(prec);
+			z2_list[i] = u_list[i] * z1;
+		}
+	});
+
+	for (int i = 0; i < pool.threads_n; i++) {
+		delete contexts[i];
+		delete rands[i];
+	}
+}
+
+// Decrypt every block: u_list[i] = z2_list[i] / Ts(z0_list[i]), at the precision prec of computation.
+void block_decrypt_parallel(thread_pool& pool, mp_bitcnt_t prec, const mpz_class& s,
+		const mpf_class* z0_list, const mpf_class* z2_list, int n, mpf_class* u_list) {
+	vector<chebyshev_context*> contexts;
+	for (int i = 0; i < pool.threads_n; i++) {
+		contexts.push_back(new chebyshev_context(prec));
+	}
+
+	parallel_for(pool, n, [&](int worker, long i) {
+		chebyshev_context& ctx = *contexts[worker];
+		mpf_class Ts_z0 = chebyshev_doubling(ctx, z0_list[i], s);
+		u_list[i].set_prec(prec);
+		u_list[i] = z2_list[i] / Ts_z0;
+	});
+
+	for (int i = 0; i < pool.threads_n; i++) {
+		delete contexts[i];
+	}
+}
+
+
+/*------------------------------- Streaming File Encryption & Decryption -------------------------------*/
+
+
+// Write a as "0.<digits>e<power>", with all the digits of its precision, such that set_str gives back a.
+string mpf_to_text(const mpf_class& a) {
+	mp_exp_t power = 0;
+	string digits = a.get_str(power, 10);
+	if (digits.empty()) {
+		return "0";
+	}
+	string sign = "";
+	if (digits[0] == '-') {
+		sign = "-";
+		digits.erase(0, 1);
+	}
+	return sign + "0." + digits + "e" + to_string(power);
+}
+
+long long stream_encrypt(thread_pool& pool, plaintext_packing packing, int char_n_per_group, mp_bitcnt_t prec_l, mp_bitcnt_t prec_m,
+		const mpf_class& x, const mpf_class& y, const mpz_class& s, const mpz_class& seed, istream& in, ostream& out) {
+	out << "chebyshev_stream " << packing << " " << char_n_per_group << " " << prec_m << "\n";
+
+	// Only one chunk of plaintext and ciphertext is in memory at a time.
+	long chunk_chars = long(STREAM_CHUNK_BLOCKS) * char_n_per_group;
+	string chunk(chunk_chars, '\0');
+	mpf_class* z0_list = new mpf_class[STREAM_CHUNK_BLOCKS];
+	mpf_class* z2_list = new mpf_class[STREAM_CHUNK_BLOCKS];
+	long long bytes_n = 0;
+
+	for (long long k = 0; ; k++) {
+		in.read(&chunk[0], chunk_chars);
+		long chunk_n = in.gcount();
+		if (chunk_n == 0) {
+			break;
+		}
+		int blocks_n = int((chunk_n + char_n_per_group - 1) / char_n_per_group);
+		mpf_class* u_list;
+		if (packing == PACKING_BINARY) {
+			u_list = message_to_packed_u_list(chunk.substr(0, chunk_n), blocks_n, char_n_per_group, prec_l);
+		}
+		else {
+			string* binary_list = message_to_binary_list(chunk.substr(0, chunk_n), blocks_n, char_n_per_group);
+			u_list = binary_list_to_u_list(binary_list, blocks_n, prec_l);
+			delete[] binary_list;
+		}
+
+		block_encrypt_parallel(pool, prec_m, x, y, s, (seed << 32) + long(k), u_list, blocks_n, z0_list, z2_list);
+		delete[] u_list;
+
+		out << blocks_n << " " << chunk_n << "\n";
+		for (int i = 0; i < blocks_n; i++) {
+			out << mpf_to_text(z0_list[i]) << " " << mpf_to_text(z2_list[i]) << "\n";
+		}
+		bytes_n += chunk_n;
+	}
+
+	delete[] z0_list;
+	delete[] z2_list;
+	return bytes_n;
+}
+
+long long stream_decrypt(thread_pool& pool, const mpz_class& s, istream& in, ostream& out) {
+	string magic;
+	int packing, char_n_per_group;
+	mp_bitcnt_t prec_m;
+	if (!(in >> magic >> packing >> char_n_per_group >> prec_m) || magic != "chebyshev_stream"
+			|| (packing != PACKING_DECIMAL && packing != PACKING_BINARY) || char_n_per_group <= 0) {
+		return -1;
+	}
+
+	mpf_class* z0_list = new mpf_class[STREAM_CHUNK_BLOCKS];
+	mpf_class* z2_list = new mpf_class[STREAM_CHUNK_BLOCKS];
+	mpf_class* u_list = new mpf_class[STREAM_CHUNK_BLOCKS];
+	long long bytes_n = 0;
+	int blocks_n;
+	long chunk_n;
+	string z0_text, z2_text;
+
+	while (in >> blocks_n >> chunk_n) {
+		// Every block but the last one of a chunk is full.
+		if (blocks_n <= 0 || blocks_n > STREAM_CHUNK_BLOCKS || chunk_n > long(blocks_n) * char_n_per_group
+				|| chunk_n <= long(blocks_n - 1) * char_n_per_group) {
+			bytes_n = -1;
+			break;
+		}
+		bool malformed = false;
+		for (int i = 0; i < blocks_n && !malformed; i++) {
+			z0_list[i].set_prec(prec_m);
+			z2_list[i].set_prec(prec_m);
+			malformed = !(in >> z0_text >> z2_text) || z0_list[i].set_str(z0_text, 10) != 0 || z2_list[i].set_str(z2_text, 10) != 0;
+		}
+		if (malformed) {
+			bytes_n = -1;
+			break;
+		}
+
+		block_decrypt_parallel(pool, prec_m, s, z0_list, z2_list, blocks_n, u_list);
+		if (packing == PACKING_BINARY) {
+			string message = packed_u_list_to_message(u_list, blocks_n, char_n_per_group);
+			out.write(message.data(), chunk_n);
+			bytes_n += chunk_n;
+			continue;
+		}
+		string* binary_list = u_list_to_binary_list(u_list, blocks_n, char_n_per_group);
+		// The trailing zero bytes of a block are lost in the floating number, the length of the chunk gives them back.
+		// A wrong key or precision recovers a u that is not 0.0101..., whose digits bitset would throw on.
+		for (int i = 0; i < blocks_n && !malformed; i++) {
+			long chars = min(long(char_n_per_group), chunk_n - long(i) * char_n_per_group);
+			binary_list[i].resize(chars * 8, '0');
+			malformed = u_list[i] < 0 || u_list[i] >= 1 || binary_list[i].find_first_not_of("01") != string::npos;
+		}
+		if (malformed) {
+			delete[] binary_list;
+			bytes_n = -1;
+			break;
+		}
+		out << binary_list_to_message(binary_list, blocks_n);
+		delete[] binary_list;
+		bytes_n += chunk_n;
+	}
+	if (bytes_n >= 0 && !in.eof()) {
+		bytes_n = -1;
+	}
+
+	delete[] z0_list;
+	delete[] z2_list;
+	delete[] u_list;
+	return bytes_n;
+}
+
+
+/*------------------------------- Parameter Sweeps -------------------------------*/
+
+
+// "d.ddddde<power>" with 6 digits, or "0".
+string mpf_to_short_text(const mpf_class& a) {
+	mp_exp_t power = 0;
+	string digits = a.get_str(power, 10, 6);
+	if (digits.empty()) {
+		return "0";
+	}
+	string sign = "";
+	if (digits[0] == '-') {
+		sign = "-";
+		digits.erase(0, 1);
+	}
+	string mantissa = digits.substr(0, 1);
+	if (digits.length() > 1) {
+		mantissa += "." + digits.substr(1);
+	}
+	return sign + mantissa + "e" + to_string(power - 1);
+}
+
+// The string "0." followed by pattern repeated to n_digits digits.
+string relation_digits(const string& pattern, int n_digits) {
+	string digits = pattern;
+	while (digits.length() < n_digits)
+		digits += pattern;
+	return "0." + digits;
+}
+
+void relation_probe_run(relation_probe& probe, const mpz_class& seed) {
+	auto start = chrono::steady_clock::now();
+	mp_bitcnt_t prec_l = digits2bit_mpf(probe.n_digits_l);
+	mp_bitcnt_t prec_m = digits2bit_mpf(probe.n_digits_m);
+	chebyshev_context ctx(prec_m);
+
+	// x = 0.111..., u = 0.0101... with l digits and error = 10^-l, as in chebyshev_gmp_relation.
+	mpf_class x(0, prec_l), u(0, prec_l), error(0, prec_l);
+	x.set_str(relation_digits("1", probe.n_digits_l), 10);
+	u.set_str(relation_digits("01", probe.n_digits_l), 10);
+	error.set_str(relation_digits("0", probe.n_digits_l - 1) + "1", 10);
+
+	mpz_class s;
+	mpz_ui_pow_ui(s.get_mpz_t(), 10, probe.key_length);
+	gmp_randclass rand(gmp_randinit_default);
+	rand.seed((seed << 32) + probe.index);
+	mpz_class half_s = s / 2;
+	mpz_class r = rand.get_z_range(half_s) + half_s;
+
+	mpf_class y = chebyshev_economical(ctx, x, s);
+	mpf_class z0 = chebyshev_economical(ctx, x, r);
+	mpf_class z2 = context_mpf(ctx);
+	z2 = u * chebyshev_economical(ctx, y, r);
+	mpf_class u_recover = context_mpf(ctx);
+	u_recover = z2 / chebyshev_economical(ctx, z0, s);
+
+	mpf_class difference = context_mpf(ctx);
+	difference = abs(u - u_recover);
+	probe.success = difference < error;
+	probe.difference = mpf_to_short_text(difference);
+	probe.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+void relation_sweep(thread_pool& pool, vector<relation_probe>& probes, const mpz_class& seed,
+		function<void(const relation_probe&)> report) {
+	// A worker runs the last task of its queue first, so the probes are submitted from the cheapest to the most expensive:
+	// every worker starts with the longest probes of its queue, and the short ones fill the gaps at the end.
+	vector<relation_probe*> order;
+	for (relation_probe& probe : probes) {
+		order.push_back(&probe);
+	}
+	auto cost = [](const relation_probe* p) {
+		return double(p->n_digits_m) * p->n_digits_m * p->key_length;
+	};
+	stable_sort(order.begin(), order.end(), [&](const relation_probe* a, const relation_probe* b) {
+		return cost(a) < cost(b);
+	});
+
+	mutex report_m;
+	for (relation_probe* probe : order) {
+		thread_pool_submit(pool, [probe, &seed, &report, &report_m](int) {
+			relation_probe_run(*probe, seed);
+			lock_guard<mutex> lock(report_m);
+			report(*probe);
+		});
+	}
+	thread_pool_wait(pool);
+}
+
+const char* relation_csv_header = "index,l,m,key_length,success,difference,seconds";
+
+string relation_probe_csv(const relation_probe& probe) {
+	return to_string(probe.index) + "," + to_string(probe.n_digits_l) + "," + to_string(probe.n_digits_m) + ","
+		+ to_string(probe.key_length) + "," + (probe.success ? "1" : "0") + "," + probe.difference + "," + to_string(probe.seconds);
+}
+
+string relation_probe_json(const relation_probe& probe) {
+	return "{\"index\": " + to_string(probe.index) + ", \"l\": " + to_string(probe.n_digits_l) + ", \"m\": " + to_string(probe.n_digits_m)
+		+ ", \"key_length\": " + to_string(probe.key_length) + ", \"success\": " + (probe.success ? "true" : "false")
+		+ ", \"difference\": \"" + probe.difference + "\", \"seconds\": " + to_string(probe.seconds) + "}";
+}
+
+vector<relation_limit> relation_limits(const vector<relation_probe>& probes) {
+	// The shortest failing length of every (l, m), then the longest success below it.
+	map<pair<int, int>, int> first_failure;
+	for (const relation_probe& probe : probes) {
+		pair<int, int> key(probe.n_digits_l, probe.n_digits_m);
+		if (first_failure.find(key) == first_failure.end()) {
+			first_failure[key] = INT_MAX;
+		}
+		if (!probe.success) {
+			first_failure[key] = min(first_failure[key], probe.key_length);
+		}
+	}
+	map<pair<int, int>, int> max_key_length;
+	for (const relation_probe& probe : probes) {
+		pair<int, int> key(probe.n_digits_l, probe.n_digits_m);
+		int& length = max_key_length[key];
+		if (probe.success && probe.key_length < first_failure[key]) {
+			length = max(length, probe.key_length);
+		}
+	}
+	vector<relation_limit> limits;
+	for (auto& entry : max_key_length) {
+		relation_limit limit = {entry.first.first, entry.first.second, entry.second};
+		limits.push_back(limit);
+	}
+	return limits;
+}
+
+
+/*------------------------------- Parallel Trials -------------------------------*/
+
+
+const char* trial_phase_names[TRIAL_PHASES] = {"keygen", "z0", "z1", "decrypt"};
+
+void relation_trials(thread_pool& pool, int n_digits_l, int n_digits_m, int key_length, const mpz_class& seed,
+		int trials_n, relation_trial* trials) {
+	mp_bitcnt_t prec_l = digits2bit_mpf(n_digits_l);
+	mp_bitcnt_t prec_m = digits2bit_mpf(n_digits_m);
+	vector<chebyshev_context*> contexts;
+	for (int i = 0; i < pool.threads_n; i++) {
+		contexts.push_back(new chebyshev_context(prec_m));
+	}
+
+	mpf_class x(0, prec_l), u(0, prec_l), error(0, prec_l);
+	x.set_str(relation_digits("1", n_digits_l), 10);
+	u.set_str(relation_digits("01", n_digits_l), 10);
+	error.set_str(relation_digits("0", n_digits_l - 1) + "1", 10);
+	mpz_class s;
+	mpz_ui_pow_ui(s.get_mpz_t(), 10, key_length);
+	mpz_class half_s = s / 2;
+
+	parallel_for(pool, trials_n, [&](int worker, long i) {
+		chebyshev_context& ctx = *contexts[worker];
+		relation_trial& trial = trials[i];
+		gmp_randclass rand(gmp_randinit_default);
+		rand.seed((seed << 32) + i);
+		mpz_class r = rand.get_z_range(half_s) + half_s;
+
+		auto t0 = chrono::steady_clock::now();
+		mpf_class y = chebyshev_economical(ctx, x, s);
+		auto t1 = chrono::steady_clock::now();
+		mpf_class z0 = chebyshev_economical(ctx, x, r);
+		auto t2 = chrono::steady_clock::now();
+		mpf_class z2 = context_mpf(ctx);
+		z2 = u * chebyshev_economical(ctx, y, r);
+		auto t3 = chrono::steady_clock::now();
+		mpf_class u_recover = context_mpf(ctx);
+		u_recover = z2 / chebyshev_economical(ctx, z0, s);
+		auto t4 = chrono::steady_clock::now();
+
+		trial.seconds[0] = chrono::duration<double>(t1 - t0).count();
+		trial.seconds[1] = chrono::duration<double>(t2 - t1).count();
+		trial.seconds[2] = chrono::duration<double>(t3 - t2).count();
+		trial.seconds[3] = chrono::duration<double>(t4 - t3).count();
+		mpf_class difference = context_mpf(ctx);
+		difference = abs(u - u_recover);
+		trial.success = difference < error;
+		trial.difference = mpf_to_short_text(difference);
+	});
+
+	for (int i = 0; i < pool.threads_n; i++) {
+		delete contexts[i];
+	}
+}
+
+latency_summary summarize_latencies(vector<double> seconds) {
+	latency_summary summary = {0, 0, 0, 0, 0, 0};
+	if (seconds.empty()) {
+		return summary;
+	}
+	sort(seconds.begin(), seconds.end());
+	long n = seconds.size();
+	auto percentile = [&](double p) {
+		long rank = long(ceil(p * n / 100));
+		return seconds[max(rank, 1L) - 1];
+	};
+	double sum = 0;
+	for (double t : seconds) {
+		sum += t;
+	}
+	summary.min = seconds[0];
+	summary.median = percentile(50);
+	summary.p90 = percentile(90);
+	summary.p99 = percentile(99);
+	summary.max = seconds[n - 1];
+	summary.mean = sum / n;
+	return summary;
+}
+
+
+/*------------------------------- Segmented Verification -------------------------------*/
+
+
+// (t_prev, t_curr) = (Ta+k(x), Ta+k+1(x)) from (Ta(x), Ta+1(x)), where two_x = 2x and t_next is a temporary.
+// The loop counter is an unsigned long, not an mpz_class, by pieces of at most ULONG_MAX steps.
+void expensive_steps(mpf_t t_prev, mpf_t t_curr, mpf_t t_next, const mpf_t two_x, mpz_class k) {
+	while (k > 0) {
+		unsigned long steps = k.fits_ulong_p() ? k.get_ui() : ULONG_MAX;
+		for (unsigned long i = 0; i < steps; i++) {
+			mpf_mul(t_next, two_x, t_curr);
+			mpf_sub(t_next, t_next, t_prev);
+			mpf_swap(t_prev, t_curr);
+			mpf_swap(t_curr, t_next);
+		}
+		k -= steps;
+	}
+}
+
+mpf_class chebyshev_expensive_segmented(thread_pool& pool, mp_bitcnt_t prec, mp_bitcnt_t seed_prec, const mpf_class& x,
+		const mpz_class& n, int segments_n, vector<expensive_segment>& segments) {
+	// No empty range.
+	if (n < segments_n) {
+		segments_n = max(int(n.get_si()), 1);
+	}
+	segments.clear();
+	segments.resize(segments_n);
+	for (int k = 0; k < segments_n; k++) {
+		segments[k].first = n * k / segments_n;
+		segments[k].last = n * (k + 1) / segments_n;
+	}
+
+	vector<chebyshev_context*> seed_contexts;
+	for (int i = 0; i < pool.threads_n; i++) {
+		seed_contexts.push_back(new chebyshev_context(seed_prec));
+	}
+	mpf_class x_seed(x, seed_prec);
+
+	parallel_for(pool, segments_n, [&](int worker, long k) {
+		chebyshev_context& ctx = *seed_contexts[worker];
+		expensive_segment& segment = segments[k];
+		auto start = chrono::steady_clock::now();
+
+		mpf_t t_prev, t_curr, t_next, two_x;
+		mpf_init2(t_prev, prec);
+		mpf_init2(t_curr, prec);
+		mpf_init2(t_next, prec);
+		mpf_init2(two_x, prec);
+		mpf_set(two_x, x.get_mpf_t());
+		mpf_mul_2exp(two_x, two_x, 1);
+		// The first range starts from T0(x) = 1 and T1(x) = x, as chebyshev_expensive.
+		if (segment.first == 0) {
+			mpf_set_ui(t_prev, 1);
+			mpf_set(t_curr, x.get_mpf_t());
+		}
+		else {
+			mpf_set(t_prev, chebyshev_economical(ctx, x_seed, segment.first).get_mpf_t());
+			mpf_set(t_curr, chebyshev_economical(ctx, x_seed, segment.first + 1).get_mpf_t());
+		}
+		expensive_steps(t_prev, t_curr, t_next, two_x, segment.last - segment.first);
+
+		segment.recurrence.set_prec(prec);
+		mpf_set(segment.recurrence.get_mpf_t(), t_prev);
+		segment.reference.set_prec(seed_prec);
+		segment.reference = chebyshev_economical(ctx, x_seed, segment.last);
+		segment.divergence.set_prec(seed_prec);
+		segment.divergence = abs(segment.recurrence - segment.reference);
+		segment.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+		mpf_clear(t_prev);
+		mpf_clear(t_curr);
+		mpf_clear(t_next);
+		mpf_clear(two_x);
+	});
+
+	for (int i = 0; i < pool.threads_n; i++) {
+		delete seed_contexts[i];
+	}
+
+	mpf_class largest(0, seed_prec);
+	for (expensive_segment& segment : segments) {
+		if (segment.divergence > largest)
+			largest = segment.divergence;
+	}
+	return largest;
+}
+
+
+/*------------------------------- Parallel Key Generation -------------------------------*/
+
+
+mpz_class random_device_bits(random_device& device, mp_bitcnt_t bits) {
+	vector<unsigned int> words((bits + 31) / 32);
+	for (unsigned int& word : words) {
+		word = device();
+	}
+	mpz_class result;
+	mpz_import(result.get_mpz_t(), words.size(), -1, sizeof(unsigned int), 0, 0, words.data());
+	// Keep bits bits.
+	mpz_fdiv_r_2exp(result.get_mpz_t(), result.get_mpz_t(), bits);
+	return result;
+}
+
+// The per-worker state of the key generation: a precision context and a random_device for every worker of a pool.
+struct keygen_workers {
+	vector<chebyshev_context*> contexts;
+	vector<random_device*> devices;
+
+	keygen_workers(int threads_n, mp_bitcnt_t prec) {
+		for (int i = 0; i < threads_n; i++) {
+			contexts.push_back(new chebyshev_context(prec));
+			devices.push_back(new random_device);
+		}
+	}
+	~keygen_workers() {
+		for (size_t i = 0; i < contexts.size(); i++) {
+			delete contexts[i];
+			delete devices[i];
+		}
+	}
+};
+
+void keygen_with(thread_pool& pool, keygen_workers& workers, mp_bitcnt_t prec, int key_length, long keys_n,
+		mpf_class* x_list, mpz_class* s_list, mpf_class* y_list) {
+	// s = s_low + a uniform integer below s_range, 10^(length-1) <= s < 10^length. The 64 more bits of the draw
+	// make the bias of the reduction below 2^-64.
+	mpz_class s_low, s_range;
+	mpz_ui_pow_ui(s_low.get_mpz_t(), 10, key_length - 1);
+	s_range = 9 * s_low;
+	mp_bitcnt_t s_bits = mpz_sizeinbase(s_range.get_mpz_t(), 2) + 64;
+
+	parallel_for(pool, keys_n, [&](int worker, long i) {
+		chebyshev_context& ctx = *workers.contexts[worker];
+		random_device& device = *workers.devices[worker];
+
+		// x = +-M / 2^prec, where the sign is one more bit of the draw.
+		mpz_class m = random_device_bits(device, prec + 1);
+		bool negative = mpz_tstbit(m.get_mpz_t(), prec);
+		mpz_clrbit(m.get_mpz_t(), prec);
+		x_list[i].set_prec(prec);
+		mpf_set_z(x_list[i].get_mpf_t(), m.get_mpz_t());
+		mpf_div_2exp(x_list[i].get_mpf_t(), x_list[i].get_mpf_t(), prec);
+		if (negative) {
+			mpf_neg(x_list[i].get_mpf_t(), x_list[i].get_mpf_t());
+		}
+
+		s_list[i] = random_device_bits(device, s_bits) % s_range + s_low;
+		y_list[i].set_prec(prec);
+		y_list[i] = chebyshev_doubling(ctx, x_list[i], s_list[i]);
+	});
+}
+
+void keygen_parallel(thread_pool& pool, mp_bitcnt_t prec, int key_length, long keys_n,
+		mpf_class* x_list, mpz_class* s_list, mpf_class* y_list) {
+	keygen_workers workers(pool.threads_n, prec);
+	keygen_with(pool, workers, prec, key_length, keys_n, x_list, s_list, y_list);
+}
+
+bool keygen_stream(thread_pool& pool, mp_bitcnt_t prec, int key_length, long long keys_n, ostream& public_out,
+		ostream& private_out) {
+	mpz_class s_last;
+	mpz_ui_pow_ui(s_last.get_mpz_t(), 10, key_length);
+	chebyshev_file_header public_header = {CHEBYSHEV_FORMAT_VERSION, FILE_PUBLIC_KEY, 0, prec, (unsigned long long)keys_n, 0, 0};
+	chebyshev_file_header private_header = {CHEBYSHEV_FORMAT_VERSION, FILE_PRIVATE_KEY, 0,
+			mpz_sizeinbase(s_last.get_mpz_t(), 2), (unsigned long long)keys_n, 0, 0};
+	write_header_binary(public_out, public_header);
+	write_header_binary(private_out, private_header);
+
+	// The contexts and the random devices are shared by all the chunks.
+	keygen_workers workers(pool.threads_n, prec);
+	mpf_class* x_list = new mpf_class[KEYGEN_CHUNK_KEYS];
+	mpz_class* s_list = new mpz_class[KEYGEN_CHUNK_KEYS];
+	mpf_class* y_list = new mpf_class[KEYGEN_CHUNK_KEYS];
+	for (long long first = 0; first < keys_n && public_out && private_out; first += KEYGEN_CHUNK_KEYS) {
+		long n = long(min<long long>(KEYGEN_CHUNK_KEYS, keys_n - first));
+		keygen_with(pool, workers, prec, key_length, n, x_list, s_list, y_list);
+		for (long i = 0; i < n; i++) {
+			write_mpf_binary(public_out, x_list[i]);
+			write_mpf_binary(public_out, y_list[i]);
+			write_mpz_binary(private_out, s_list[i]);
+		}
+	}
+	delete[] x_list;
+	delete[] s_list;
+	delete[] y_list;
+	return bool(public_out) && bool(private_out);
+}
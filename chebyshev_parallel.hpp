@@ -0,0 +1,224 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This Program is the Parallel Part of the Library of our Chebyshev Article: a work-stealing thread pool,
+// and the block encryption & decryption, the parameter sweeps, the trials, the segmented verifier and the key generation
+// running on it.
+#ifndef CHEBYSHEV_PARALLEL_HPP
+#define CHEBYSHEV_PARALLEL_HPP
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <random>
+
+#include <gmpxx.h>
+#include "chebyshev.hpp"
+
+using namespace std;
+
+
+/*------------------------------- Work-Stealing Thread Pool -------------------------------*/
+
+
+// The tasks of one worker. The owner takes from the back, the other workers steal from the front.
+struct worker_queue {
+	mutex m;
+	deque<function<void(int)>> tasks;
+};
+
+// threads_n workers, each with its own queue. A task is called with the index of the worker running it,
+// such that it can use the per-worker state (precision context, random generator) of that index.
+// A worker with an empty queue steals from the others, so long and short tasks balance over all cores.
+struct thread_pool {
+	int threads_n;
+	vector<thread> threads;
+	vector<worker_queue*> queues;
+
+	mutex m;
+	condition_variable work_cv;
+	condition_variable done_cv;
+	// The tasks submitted and not finished, and the tasks still in a queue.
+	long pending;
+	long queued;
+	int next_queue;
+	bool stop;
+
+	thread_pool(int threads_n);
+	~thread_pool();
+	thread_pool(const thread_pool&) = delete;
+	thread_pool& operator=(const thread_pool&) = delete;
+};
+
+// The number of cores, at least 1.
+int hardware_threads();
+
+// Put a task in the queues of pool, round robin.
+void thread_pool_submit(thread_pool& pool, function<void(int)> task);
+
+// Wait until every task submitted to pool is finished.
+void thread_pool_wait(thread_pool& pool);
+
+// Call body(worker, i) for every 0 <= i < n on pool, by chunks of about n/(8*threads_n), and wait for all of them.
+void parallel_for(thread_pool& pool, long n, function<void(int, long)> body);
+
+
+/*------------------------------- Parallel Block Encryption & Decryption -------------------------------*/
+
+
+// The blocks of one random stream in block_encrypt_parallel.
+#define BLOCK_NONCE_CHUNK 256
+
+// Encrypt every block with its own nonce, at the precision prec of computation:
+// r_i is a random number between s/2 and s, z0_list[i] = Tr_i(x), and z2_list[i] = u_list[i] * Tr_i(y).
+// The random stream of the blocks BLOCK_NONCE_CHUNK*c to BLOCK_NONCE_CHUNK*(c+1) - 1 is seeded by (seed, c), so the
+// ciphertext does not depend on the number of threads, and every block is written at its own index.
+void block_encrypt_parallel(thread_pool& pool, mp_bitcnt_t prec, const mpf_class& x, const mpf_class& y, const mpz_class& s,
+		const mpz_class& seed, const mpf_class* u_list, int n, mpf_class* z0_list, mpf_class* z2_list);
+
+// Decrypt every block: u_list[i] = z2_list[i] / Ts(z0_list[i]), at the precision prec of computation.
+void block_decrypt_parallel(thread_pool& pool, mp_bitcnt_t prec, const mpz_class& s,
+		const mpf_class* z0_list, const mpf_class* z2_list, int n, mpf_class* u_list);
+
+
+/*------------------------------- Streaming File Encryption & Decryption -------------------------------*/
+
+
+// The blocks read, encrypted and written at once by stream_encrypt, so the memory does not depend on the file size.
+#define STREAM_CHUNK_BLOCKS 4096
+
+// Encrypt the bytes of in to out, chunk by chunk, with char_n_per_group chars per block packed by packing at the precision prec_l,
+// and the computation at the precision prec_m. The ciphertext is text: a header line
+// "chebyshev_stream <packing> <char_n_per_group> <prec_m>", then for every chunk a line "<blocks> <bytes>" and one line "z0 z2" per block.
+// The nonces of chunk k come from the seed (seed, k). Return the number of bytes read.
+long long stream_encrypt(thread_pool& pool, plaintext_packing packing, int char_n_per_group, mp_bitcnt_t prec_l, mp_bitcnt_t prec_m,
+		const mpf_class& x, const mpf_class& y, const mpz_class& s, const mpz_class& seed, istream& in, ostream& out);
+
+// Decrypt a ciphertext of stream_encrypt from in to out, chunk by chunk.
+// Return the number of bytes written, or -1 if the ciphertext is malformed.
+long long stream_decrypt(thread_pool& pool, const mpz_class& s, istream& in, ostream& out);
+
+
+/*------------------------------- Parameter Sweeps -------------------------------*/
+
+
+// One probe of the relation between l, m and s of chebyshev_gmp_relation: x = 0.111..., u = 0.0101... with l digits,
+// s = 10^key_length, y = Ts(x), a random r between s/2 and s, z0 = Tr(x), z2 = u*Tr(y), and u recovered as z2 / Ts(z0)
+// at m digits, compared with error = 10^-l.
+struct relation_probe {
+	int index;
+	int n_digits_l;
+	int n_digits_m;
+	int key_length;
+
+	bool success;
+	// |u - u_recover| with 6 digits, and the wall-clock seconds of the probe.
+	string difference;
+	double seconds;
+};
+
+// Run probe with its own precision context at m digits, and the random r from (seed, probe.index).
+void relation_probe_run(relation_probe& probe, const mpz_class& seed);
+
+// Run every probe on pool, the most expensive (m^2 * key_length) first such that the last ones are short,
+// and call report once per finished probe, one at a time, in the order they finish.
+void relation_sweep(thread_pool& pool, vector<relation_probe>& probes, const mpz_class& seed,
+		function<void(const relation_probe&)> report);
+
+// One probe as a CSV row (after the header relation_csv_header) or as a JSON object on one line.
+extern const char* relation_csv_header;
+string relation_probe_csv(const relation_probe& probe);
+string relation_probe_json(const relation_probe& probe);
+
+// The largest length of s of one (l, m) that decrypts, with every shorter length of the probes decrypting as well.
+// When m is far too small, Ts(z0) and z2 lose all their digits together and a long s can give back u by chance,
+// so a success after the first failure is not counted. 0 if the shortest length already fails.
+struct relation_limit {
+	int n_digits_l;
+	int n_digits_m;
+	int max_key_length;
+};
+
+// The relation_limit of every (l, m) of the finished probes, sorted by l then m.
+vector<relation_limit> relation_limits(const vector<relation_probe>& probes);
+
+
+/*------------------------------- Parallel Trials -------------------------------*/
+
+
+// The phases of a trial: keygen y = Ts(x), z0 = Tr(x), z1 = Tr(y) with z2 = u*z1, and decryption z2 / Ts(z0).
+#define TRIAL_PHASES 4
+extern const char* trial_phase_names[TRIAL_PHASES];
+
+// The wall-clock seconds of every phase of one trial, and whether u was recovered within error.
+struct relation_trial {
+	double seconds[TRIAL_PHASES];
+	bool success;
+	string difference;
+};
+
+// Run trials_n trials of chebyshev_gmp_relation_average (l, m digits, s = 10^key_length) on pool, with one
+// precision context per worker. The trial i draws r between s/2 and s from its own stream seeded by (seed, i),
+// so the trials do not depend on the number of threads.
+void relation_trials(thread_pool& pool, int n_digits_l, int n_digits_m, int key_length, const mpz_class& seed,
+		int trials_n, relation_trial* trials);
+
+// The distribution of latencies, in seconds. The percentiles are nearest-rank: the smallest value with at least
+// p percent of the values at or below it.
+struct latency_summary {
+	double min, median, p90, p99, max, mean;
+};
+
+latency_summary summarize_latencies(vector<double> seconds);
+
+
+/*------------------------------- Segmented Verification -------------------------------*/
+
+
+// One segment [first, last) of chebyshev_expensive_segmented. recurrence is Tlast(x) by the steps of the expensive
+// method at the precision of computation, from the seeds (Tfirst(x), Tfirst+1(x)) of the economical method at the
+// precision of the seeds, reference is Tlast(x) by the economical method at the precision of the seeds,
+// and divergence = |recurrence - reference|.
+struct expensive_segment {
+	mpz_class first;
+	mpz_class last;
+	mpf_class recurrence;
+	mpf_class reference;
+	mpf_class divergence;
+	double seconds;
+};
+
+// Check the expensive method for Tn(x) on pool: [0, n) is split into segments_n ranges of the same length, and every range
+// runs its steps at the precision prec from its own seeds at the precision seed_prec (larger than prec), all in parallel.
+// segments gets one entry per range, in order, and the largest divergence is returned.
+mpf_class chebyshev_expensive_segmented(thread_pool& pool, mp_bitcnt_t prec, mp_bitcnt_t seed_prec, const mpf_class& x,
+		const mpz_class& n, int segments_n, vector<expensive_segment>& segments);
+
+
+/*------------------------------- Parallel Key Generation -------------------------------*/
+
+
+// The keys generated, then written, at once by keygen_stream, so the memory does not depend on the number of keys.
+#define KEYGEN_CHUNK_KEYS 1024
+
+// A uniform random integer of bits bits, from the words of device.
+mpz_class random_device_bits(random_device& device, mp_bitcnt_t bits);
+
+// Generate keys_n key pairs at the precision prec on pool: x uniform in (-1, 1) with prec random bits, s uniform among
+// the integers of key_length digits, and y = Ts(x). The randomness of every key comes from random_device (the entropy
+// of the system, not a seeded generator), one per worker, and every worker keeps one precision context for all its keys.
+void keygen_parallel(thread_pool& pool, mp_bitcnt_t prec, int key_length, long keys_n,
+		mpf_class* x_list, mpz_class* s_list, mpf_class* y_list);
+
+// Generate keys_n key pairs as keygen_parallel, KEYGEN_CHUNK_KEYS at a time, and write them in the binary format:
+// public_out is a public key file of keys_n pairs (x, y), and private_out a private key file of the keys_n s, in the
+// same order. Return false if a stream fails.
+bool keygen_stream(thread_pool& pool, mp_bitcnt_t prec, int key_length, long long keys_n, ostream& public_out,
+		ostream& private_out);
+
+#endif
@@ -0,0 +1,141 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This program sweeps the relation between l, m and s of chebyshev_gmp_relation over a grid, in parallel.
+// Every (l, m, length of s) of the ranges is one independent probe (keygen, encryption, decryption, comparison with
+// error = 10^-l), run by relation_sweep on the work-stealing pool with its own precision context, the most
+// expensive probes first. One row per probe is printed as soon as it is finished, in CSV or in JSON (one object per line).
+// A probe far beyond its (l, m) can succeed by chance, as every digit of Ts(z0) and z2 is lost, so the table of the paper,
+// printed at the end, is the largest length of s of every (l, m) before its first failure, as chebyshev_gmp_relation stops.
+// A range is "first:last:step", or "first:last:xfactor" for first, first*factor, ... (as s *= s doubles the length),
+// "first:last" for the step 1, or one value.
+// With a calibration file, the probes are also added to its records (chebyshev_calibration.hpp), which the programs
+// that encrypt read to choose m.
+
+// In order to compile and run this program, you need to install two libraries: GMP and MPFR.
+// Compile: g++ -o chebyshev_relation_sweep chebyshev_relation_sweep.cpp chebyshev.cpp chebyshev_parallel.cpp chebyshev_calibration.cpp -lmpfr -lgmpxx -lgmp -pthread
+// Run: ./chebyshev_relation_sweep <range of l> <range of m> <range of length of s> <threads> <csv|json> [calibration file]
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gmpxx.h>
+#include <mpreal.h>
+#include "chebyshev.hpp"
+#include "chebyshev_parallel.hpp"
+#include "chebyshev_calibration.hpp"
+
+#include <time.h>
+
+using namespace std;
+
+// The values of "first:last:step", "first:last:xfactor", "first:last" (step 1) or "value",
+// or an empty list if text is not a range.
+vector<int> parse_range(const string& text) {
+	vector<int> values;
+	size_t a = text.find(':');
+	if (a == string::npos) {
+		int value = atoi(text.c_str());
+		if (value > 0)
+			values.push_back(value);
+		return values;
+	}
+	size_t b = text.find(':', a + 1);
+	int first = atoi(text.substr(0, a).c_str());
+	int last = atoi(text.substr(a + 1, b == string::npos ? string::npos : b - a - 1).c_str());
+	string step = (b == string::npos) ? "1" : text.substr(b + 1);
+	bool multiply = !step.empty() && step[0] == 'x';
+	int k = atoi(step.c_str() + (multiply ? 1 : 0));
+	if (first <= 0 || k <= 0 || (multiply && k < 2)) {
+		return values;
+	}
+	for (int v = first; v <= last; v = multiply ? v * k : v + k) {
+		values.push_back(v);
+	}
+	return values;
+}
+
+int main (int argc, char* argv[]) {
+	vector<int> l_values, m_values, length_values;
+	int threads_n = 0;
+	string format, calibration_path;
+	if (argc == 6 || argc == 7) {
+		l_values = parse_range(argv[1]);
+		m_values = parse_range(argv[2]);
+		length_values = parse_range(argv[3]);
+		threads_n = atoi(argv[4]);
+		format = argv[5];
+		calibration_path = (argc == 7) ? argv[6] : "";
+	}
+	if ((argc != 6 && argc != 7) || l_values.empty() || m_values.empty() || length_values.empty() || threads_n < 0
+			|| (format != "csv" && format != "json")) {
+		cout << "Notice: If you want to run this program, you need 5 inputs, such that: " << endl;
+		cout << "Example: ./chebyshev_relation_sweep <range of l> <range of m> <range of length of s> <threads> <csv|json> [calibration file] ";
+		cout << "(range first:last:step or first:last:xfactor, threads 0 for all the cores) " << endl;
+		cout << "For example: ./chebyshev_relation_sweep 50:100:50 60:120:60 1:64:x2 0 csv chebyshev_calibration.bin" << endl;
+		return 0;
+	}
+	if (threads_n == 0) {
+		threads_n = hardware_threads();
+	}
+
+	vector<relation_probe> probes;
+	for (int l : l_values) {
+		for (int m : m_values) {
+			for (int length : length_values) {
+				relation_probe probe;
+				probe.index = probes.size();
+				probe.n_digits_l = l;
+				probe.n_digits_m = m;
+				probe.key_length = length;
+				probes.push_back(probe);
+			}
+		}
+	}
+
+	thread_pool pool(threads_n);
+	mpz_class seed = time(NULL);
+	cerr << probes.size() << " probes on " << threads_n << " threads, seed " << seed << endl;
+	if (format == "csv") {
+		cout << relation_csv_header << endl;
+	}
+	int successes = 0;
+	relation_sweep(pool, probes, seed, [&](const relation_probe& probe) {
+		cout << (format == "csv" ? relation_probe_csv(probe) : relation_probe_json(probe)) << endl;
+		successes += probe.success;
+	});
+	cerr << successes << " of " << probes.size() << " probes recovered u" << endl;
+
+	// The table: one more CSV block after an empty line, or one JSON object per (l, m).
+	if (format == "csv") {
+		cout << endl << "l,m,max_key_length" << endl;
+	}
+	for (const relation_limit& limit : relation_limits(probes)) {
+		if (format == "csv") {
+			cout << limit.n_digits_l << "," << limit.n_digits_m << "," << limit.max_key_length << endl;
+		}
+		else {
+			cout << "{\"l\": " << limit.n_digits_l << ", \"m\": " << limit.n_digits_m << ", \"max_key_length\": "
+					<< limit.max_key_length << "}" << endl;
+		}
+	}
+
+	if (!calibration_path.empty()) {
+		calibration_table calibration;
+		if (!load_calibration(calibration_path, calibration)) {
+			cerr << calibration_path << " is not a calibration file!" << endl;
+			return 1;
+		}
+		// The probes of one (l, m) are in the order of their key lengths, from the shortest one.
+		for (relation_probe& probe : probes) {
+			calibration_add(calibration, probe.n_digits_l, probe.n_digits_m, probe.key_length, probe.success);
+		}
+		if (!save_calibration(calibration_path, calibration)) {
+			cerr << "Cannot write " << calibration_path << endl;
+			return 1;
+		}
+		cerr << calibration.records.size() << " records of (l, m) in " << calibration_path << endl;
+	}
+
+	return 0;
+}
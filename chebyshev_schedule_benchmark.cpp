@@ -0,0 +1,90 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This program compares the recodings of the degree s for the matrix power Mx^s: binary, k-ary, sliding window and wNAF.
+// For s = 10^8, 10^100 and 10^1000 it prints, for every recoding, the number of multiplications by a table entry
+// (the squarings are the same for all of them), the reduction against the binary schedule, the time of
+// chebyshev_scheduled, and the difference of the result with the binary schedule.
+// s must have less digits than m, otherwise the error grows with every squaring until the mpf exponent overflows.
+
+// In order to compile and run this program, you need to install two libraries: GMP and MPFR.
+// Compile: g++ -o chebyshev_schedule_benchmark chebyshev_schedule_benchmark.cpp chebyshev.cpp -lmpfr -lgmpxx -lgmp
+// Run: ./chebyshev_schedule_benchmark <precision m>
+#include <iostream>
+#include <string>
+
+#include <gmpxx.h>
+#include <mpreal.h>
+#include "chebyshev.hpp"
+
+#include <time.h>
+
+using namespace std;
+
+int main (int argc, char* argv[]) {
+	int n_digits_m;
+	if (argc == 2) {
+		n_digits_m = atoi(argv[1]);
+	}
+	else {
+		cout << "Notice: If you want to run this program, you need 1 input, such that: " << endl;
+		cout << "Example: ./chebyshev_schedule_benchmark <precision m> " << endl;
+		cout << "For example: ./chebyshev_schedule_benchmark 120" << endl;
+		return 0;
+	}
+
+	/*----------------------------------- Preparation/Assignment -----------------------------------*/
+
+	chebyshev_context ctx(digits2bit_mpf(n_digits_m));
+	cout << "Precision m of mpf for computation is: " << ctx.prec << ", where 3.2 bit represents one decimal digit in average. ";
+	cout << "Which is " << int(ctx.prec / 3.2) << " digits." << endl << endl;
+
+	// Choose x as 0.111... with precision m number of digits.
+	string tmp_string = "1";
+	string x_string = "1";
+	while (x_string.length() < n_digits_m)
+		x_string += tmp_string;
+	mpf_class x = context_mpf(ctx, "0." + x_string);
+
+	/*----------------------------------- Start Experiment -----------------------------------*/
+
+	int n_lengths = 3;
+	int lengths[] = {8, 100, 1000};
+	int n_schedules = 7;
+	string names[] = {"binary", "4-ary", "sliding window 4", "sliding window 5", "wNAF 2", "wNAF 4", "wNAF 6"};
+	int repetitions = 20;
+
+	clock_t start, end;
+	cout.precision(6);
+	for (int i = 0; i < n_lengths; i++) {
+		mpz_class s;
+		mpz_ui_pow_ui(s.get_mpz_t(), 10, lengths[i]);
+		cout << "s = 10^" << lengths[i] << ", " << mpz_sizeinbase(s.get_mpz_t(), 2) << " bits" << endl;
+		if (lengths[i] >= n_digits_m) {
+			cout << "Skipped, precision m is too small for this s." << endl << endl;
+			continue;
+		}
+
+		chebyshev_schedule schedules[] = {schedule_binary(s), schedule_k_ary(s, 4), schedule_sliding_window(s, 4), schedule_sliding_window(s, 5),
+				schedule_wnaf(s, 2), schedule_wnaf(s, 4), schedule_wnaf(s, 6)};
+		mpf_class y_binary = chebyshev_scheduled(ctx, x, schedules[0]);
+		int multiplications_binary = schedule_multiplications(schedules[0]);
+
+		for (int j = 0; j < n_schedules; j++) {
+			mpf_class y;
+			start = clock();
+			for (int k = 0; k < repetitions; k++) {
+				y = chebyshev_scheduled(ctx, x, schedules[j]);
+			}
+			end = clock();
+			int multiplications = schedule_multiplications(schedules[j]);
+			mpf_class difference = y - y_binary;
+			cout << names[j] << ": " << multiplications << " multiplications (" << 100.0 * (multiplications_binary - multiplications) / multiplications_binary << "% less), ";
+			cout << schedule_squarings(schedules[j]) << " squarings, table of " << schedules[j].max_digit << ", ";
+			cout << "time = " << double(end - start)/CLOCKS_PER_SEC/repetitions << "s, difference = " << difference.get_d() << endl;
+		}
+		cout << endl;
+	}
+
+	return 0;
+}
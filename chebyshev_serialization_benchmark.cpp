@@ -0,0 +1,149 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This program compares the two ways to save and load a ciphertext of n blocks (z0, z2) at the precision m:
+// the decimal text of get_str/set_str, as the drivers print the numbers, and the binary format of write_ciphertext_binary,
+// which exports the limbs of every mpf with mpz_export.
+// For both it prints the size, the time to write and to read, and checks that the numbers read are the numbers written.
+// A public and a private key are also written and read back in the binary format.
+
+// In order to compile and run this program, you need to install two libraries: GMP and MPFR.
+// Compile: g++ -o chebyshev_serialization_benchmark chebyshev_serialization_benchmark.cpp chebyshev.cpp -lmpfr -lgmpxx -lgmp
+// Run: ./chebyshev_serialization_benchmark <precision m> <number of blocks>
+#include <iostream>
+#include <string>
+#include <sstream>
+
+#include <gmpxx.h>
+#include <mpreal.h>
+#include "chebyshev.hpp"
+
+#include <time.h>
+
+using namespace std;
+
+int main (int argc, char* argv[]) {
+	int n_digits_m, blocks_n;
+	if (argc == 3) {
+		n_digits_m = atoi(argv[1]);
+		blocks_n = atoi(argv[2]);
+	}
+	else {
+		cout << "Notice: If you want to run this program, you need 2 inputs, such that: " << endl;
+		cout << "Example: ./chebyshev_serialization_benchmark <precision m> <number of blocks> " << endl;
+		cout << "For example: ./chebyshev_serialization_benchmark 10000 1000" << endl;
+		return 0;
+	}
+
+	/*----------------------------------- Preparation/Assignment -----------------------------------*/
+
+	mp_bitcnt_t prec_m = digits2bit_mpf(n_digits_m);
+	cout << "Precision m of mpf for computation is: " << prec_m << ", where 3.2 bit represents one decimal digit in average. ";
+	cout << "Which is " << int(prec_m / 3.2) << " digits." << endl;
+
+	// Random ciphertext numbers in (-1, 1), z2 is a product so it is smaller.
+	gmp_randclass rand(gmp_randinit_default);
+	mpf_class* z0_list = new mpf_class[blocks_n];
+	mpf_class* z2_list = new mpf_class[blocks_n];
+	for (int i = 0; i < blocks_n; i++) {
+		z0_list[i].set_prec(prec_m);
+		z2_list[i].set_prec(prec_m);
+		z0_list[i] = rand.get_f(prec_m);
+		z2_list[i] = rand.get_f(prec_m) * rand.get_f(prec_m);
+		if (i % 2 == 1) {
+			z0_list[i] = -z0_list[i];
+		}
+	}
+
+	/*----------------------------------- Start Experiment -----------------------------------*/
+
+	clock_t start, end;
+
+	// Decimal text: every number with all the digits of its precision.
+	start = clock();
+	stringstream text;
+	mp_exp_t power;
+	for (int i = 0; i < blocks_n; i++) {
+		text << z0_list[i].get_str(power, 10) << " " << power << " ";
+		text << z2_list[i].get_str(power, 10) << " " << power << "\n";
+	}
+	end = clock();
+	double time_text_write = double(end - start)/CLOCKS_PER_SEC;
+	size_t text_size = text.str().length();
+
+	start = clock();
+	mpf_class* z0_text = new mpf_class[blocks_n];
+	mpf_class* z2_text = new mpf_class[blocks_n];
+	string digits;
+	for (int i = 0; i < blocks_n; i++) {
+		for (int j = 0; j < 2; j++) {
+			mpf_class& z = (j == 0) ? z0_text[i] : z2_text[i];
+			text >> digits >> power;
+			bool negative = (digits[0] == '-');
+			z.set_prec(prec_m);
+			z.set_str((negative ? "-0." + digits.substr(1) : "0." + digits) + "e" + to_string(power), 10);
+		}
+	}
+	end = clock();
+	double time_text_read = double(end - start)/CLOCKS_PER_SEC;
+
+	// Binary format.
+	start = clock();
+	stringstream binary;
+	chebyshev_file_header header = {CHEBYSHEV_FORMAT_VERSION, FILE_CIPHERTEXT, PACKING_BINARY, prec_m, (unsigned long long)blocks_n, 0, 0};
+	write_ciphertext_binary(binary, header, z0_list, z2_list);
+	end = clock();
+	double time_binary_write = double(end - start)/CLOCKS_PER_SEC;
+	size_t binary_size = binary.str().length();
+
+	start = clock();
+	mpf_class* z0_binary;
+	mpf_class* z2_binary;
+	chebyshev_file_header header_read;
+	bool read_ok = read_ciphertext_binary(binary, header_read, z0_binary, z2_binary);
+	end = clock();
+	double time_binary_read = double(end - start)/CLOCKS_PER_SEC;
+
+	// The binary format gives back the same numbers, the text gives them back up to the last digit.
+	int binary_equal = 0;
+	mpf_class difference, max_difference_text = 0;
+	for (int i = 0; read_ok && i < blocks_n; i++) {
+		if (z0_binary[i] == z0_list[i] && z2_binary[i] == z2_list[i]) {
+			binary_equal++;
+		}
+		difference = abs(z0_text[i] - z0_list[i]) + abs(z2_text[i] - z2_list[i]);
+		if (difference > max_difference_text) {
+			max_difference_text = difference;
+		}
+	}
+
+	cout.precision(6);
+	cout << endl << "format, size (bytes), write time, read time" << endl;
+	cout << "text, " << text_size << ", " << time_text_write << "s, " << time_text_read << "s" << endl;
+	cout << "binary, " << binary_size << ", " << time_binary_write << "s, " << time_binary_read << "s" << endl;
+	cout << "Text is " << double(text_size) / binary_size << " times larger, binary is " << (time_text_write + time_text_read) / (time_binary_write + time_binary_read) << " times faster." << endl;
+	cout << "Binary: " << binary_equal << " of " << blocks_n << " blocks read back exactly, ";
+	cout << "text: largest difference = " << max_difference_text.get_d() << endl;
+
+	// Keys.
+	stringstream key_file;
+	mpz_class s;
+	mpz_ui_pow_ui(s.get_mpz_t(), 10, 100);
+	write_public_key_binary(key_file, prec_m, z0_list[0], z2_list[0]);
+	write_private_key_binary(key_file, s);
+	mp_bitcnt_t prec_key;
+	mpf_class x, y;
+	mpz_class s_read;
+	bool key_ok = read_public_key_binary(key_file, prec_key, x, y) && read_private_key_binary(key_file, s_read);
+	cout << "Keys read back: " << ((key_ok && x == z0_list[0] && y == z2_list[0] && s_read == s) ? "yes" : "no") << endl;
+
+	delete[] z0_list;
+	delete[] z2_list;
+	delete[] z0_text;
+	delete[] z2_text;
+	if (read_ok) {
+		delete[] z0_binary;
+		delete[] z2_binary;
+	}
+	return 0;
+}
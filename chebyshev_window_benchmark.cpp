@@ -0,0 +1,127 @@
+// Author: Xiaoqi LIU, GTIIT
+// Date: October 2026
+
+// This program measures the number of encryptions per second with a fixed public key (x, y = Ts(x)).
+// Every encryption chooses a random r between s/2 and s, and computes z0 = Tr(x), z1 = Tr(y), z2 = u*z1.
+// We compare chebyshev_economical with chebyshev_windowed, which uses one chebyshev_window_table for x and one for y,
+// built once for the key pair, and with chebyshev_ladder for reference.
+
+// In order to compile and run this program, you need to install two libraries: GMP and MPFR.
+// Compile: g++ -o chebyshev_window_benchmark chebyshev_window_benchmark.cpp chebyshev.cpp -lmpfr -lgmpxx -lgmp
+// Run: ./chebyshev_window_benchmark <precision m> <length of secret key> <window width> <memory budget in MB> (s = 10^length)
+#include <iostream>
+#include <string>
+
+#include <gmpxx.h>
+#include <mpreal.h>
+#include "chebyshev.hpp"
+
+#include <time.h>
+
+using namespace std;
+
+int main (int argc, char* argv[]) {
+	int n_digits_m, n_s, window, memory_budget_mb;
+	if (argc == 5) {
+		n_digits_m = atoi(argv[1]);
+		n_s = atoi(argv[2]);
+		window = atoi(argv[3]);
+		memory_budget_mb = atoi(argv[4]);
+	}
+	if (argc != 5 || window < 1 || window > WINDOW_MAX_WIDTH) {
+		cout << "Notice: If you want to run this program, you need 4 inputs, such that: " << endl;
+		cout << "Example: ./chebyshev_window_benchmark <precision m> <length of secret key> <window width> <memory budget in MB> (s = 10^length, width 1 to " << WINDOW_MAX_WIDTH << ") " << endl;
+		cout << "For example: ./chebyshev_window_benchmark 120 8 6 64" << endl;
+		return 0;
+	}
+
+	/*----------------------------------- Preparation/Assignment -----------------------------------*/
+
+	// chebyshev_economical works at the default precision, so we set it to m as well.
+	mpf_set_default_prec(digits2bit_mpf(n_digits_m));
+	chebyshev_context ctx(digits2bit_mpf(n_digits_m));
+	cout << "Precision m of mpf for computation is: " << ctx.prec << ", where 3.2 bit represents one decimal digit in average. ";
+	cout << "Which is " << int(ctx.prec / 3.2) << " digits." << endl;
+
+	// Choose x as 0.111... with precision m number of digits.
+	string tmp_string = "1";
+	string x_string = "1";
+	while (x_string.length() < n_digits_m)
+		x_string += tmp_string;
+	mpf_class x = context_mpf(ctx, "0." + x_string);
+
+	// Choose u as 0.0101...
+	tmp_string = "01";
+	string plaintext_string = "01";
+	while (plaintext_string.length() < n_digits_m)
+		plaintext_string += tmp_string;
+	mpf_class u = context_mpf(ctx, "0." + plaintext_string);
+
+	mpz_class s;
+	mpz_ui_pow_ui(s.get_mpz_t(), 10, n_s);
+	mpf_class y = chebyshev_ladder(ctx, x, s);
+	cout << "s = 10^" << n_s << endl;
+
+	clock_t start, end;
+	start = clock();
+	mp_bitcnt_t max_bits = mpz_sizeinbase(s.get_mpz_t(), 2);
+	size_t memory_budget = size_t(memory_budget_mb) * 1024 * 1024;
+	chebyshev_window_table table_x(x, ctx.prec, max_bits, window, memory_budget / 2);
+	chebyshev_window_table table_y(y, ctx.prec, max_bits, window, memory_budget / 2);
+	end = clock();
+	cout << "Window width = " << table_x.window << ", " << table_x.windows_n << " windows, ";
+	cout << 2 * chebyshev_window_table_memory(ctx.prec, max_bits, table_x.window) / 1024 << " KB for the tables of x and y" << endl;
+	cout << "Time to build the tables = " << double(end - start)/CLOCKS_PER_SEC << "s" << endl << endl;
+
+	/*----------------------------------- Start Experiment -----------------------------------*/
+
+	int n_encryptions = 1000;
+	mpz_class* r_list = new mpz_class[n_encryptions];
+	gmp_randclass rand(gmp_randinit_default);
+	for (int i = 0; i < n_encryptions; i++) {
+		// Get a random number between s/2 and s.
+		r_list[i] = rand.get_z_range(s/2) + s/2;
+	}
+
+	mpf_class z0, z1, z2;
+	mpf_class difference = 0;
+
+	start = clock();
+	for (int i = 0; i < n_encryptions; i++) {
+		z0 = chebyshev_economical(x, r_list[i]);
+		z1 = chebyshev_economical(y, r_list[i]);
+		z2 = u * z1;
+	}
+	end = clock();
+	double time_economical = double(end - start)/CLOCKS_PER_SEC;
+
+	start = clock();
+	for (int i = 0; i < n_encryptions; i++) {
+		z0 = chebyshev_ladder(ctx, x, r_list[i]);
+		z1 = chebyshev_ladder(ctx, y, r_list[i]);
+		z2 = u * z1;
+	}
+	end = clock();
+	double time_ladder = double(end - start)/CLOCKS_PER_SEC;
+
+	start = clock();
+	for (int i = 0; i < n_encryptions; i++) {
+		z0 = chebyshev_windowed(table_x, r_list[i]);
+		z1 = chebyshev_windowed(table_y, r_list[i]);
+		z2 = u * z1;
+	}
+	end = clock();
+	double time_windowed = double(end - start)/CLOCKS_PER_SEC;
+
+	// Compare the last ciphertext with the economical one.
+	difference = z0 - chebyshev_economical(x, r_list[n_encryptions - 1]);
+
+	cout.precision(6);
+	cout << "Economical: " << n_encryptions / time_economical << " encryptions/s" << endl;
+	cout << "Ladder:     " << n_encryptions / time_ladder << " encryptions/s" << endl;
+	cout << "Windowed:   " << n_encryptions / time_windowed << " encryptions/s" << endl;
+	cout << "Difference of z0 = " << difference.get_d() << endl;
+
+	delete[] r_list;
+	return 0;
+}
@@ -2,7 +2,7 @@
 // Date: September 2024
 
 // This example consists of 2 parts, firstly it will produce a list with large numbers, here is "s_array[]", you can increase the number by increasing the number of iterations,
-// and it will use the s_array to produce a "y_array[]" which is the result of Ts(x), namely, the image of x of chebyshev polynomial in s degree, both in expensive and economical algorithms. 
+// and it will use the s_array to produce a "y_array[]" which is the result of Ts(x), namely, the image of x of chebyshev polynomial in s degree, both in expensive and economical algorithms, and with a cache of the powers Mx^(2^k) shared by all s. 
 // Then it will use the last element of s_array as secret key s, and secondly last element as r, and perform the encryption & decryption procedures of Chebyshev based cryptosystem.
 // Be careful to notice that the correctness of recovered plaintext u is related to the precision of MPF structure, and here I set it to be 320, which is 100 digits.
 
@@ -76,6 +76,16 @@ int main() {
 	}
 	end = clock();
 	cout << "Total time of economical iteration = " << double(end - start)/CLOCKS_PER_SEC << "s" << endl;
+	cout << endl;
+
+	// The same x for every s, so the cache keeps Mx^(2^k) from one s to the next one.
+	start = clock();
+	chebyshev_power_cache cache(x, mpf_get_default_prec());
+	for (int i = 1; i < iterations; i++) {
+		cout << "(" << x << ", " << s_array[i] << ") = " << chebyshev_cached(cache, s_array[i]) << endl;
+	}
+	end = clock();
+	cout << "Total time of cached iteration = " << double(end - start)/CLOCKS_PER_SEC << "s, with " << cache.n_squarings << " squarings" << endl;
 
 
 	/*----------------------------------- Start Experiment -----------------------------------*/